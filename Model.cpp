@@ -1,15 +1,38 @@
 #include "Model.h"
 
 // Make sure manually change the dimensions of n based on the chosen n.
-Model::Model() : n(4)
+Model::Model() : n(4), tables(std::make_shared<const ModelTables>(n))
 {
     initializeBoard();
     currentPivotIndex = n * n - 1;
     randomizeBoard();
+}
+
+// Builds the tables for an n x n board derived from the given board, then loads it. Used by callers that supply their own boards.
+Model::Model(const std::string& board) : Model(std::make_shared<const ModelTables>(static_cast<int>(std::lround(std::sqrt(board.size())))), board) {}
+
+// Loads the given board using tables that were built beforehand, so callers solving many boards of one size (e.g. the solver daemon) build them only once.
+Model::Model(std::shared_ptr<const ModelTables> tables, const std::string& board) : n(tables->n), tables(std::move(tables))
+{
+    initializeBoard();
+    loadBoard(board);
+}
+
+ModelTables::ModelTables(const int& n) : n(n)
+{
+    generateValidNeighbors();
     precomputeManhattanDistances();
     precomputeChebyshevDistances();
 }
 
+// Replaces the current board with the given one and clears any previous solution. The precomputed tables are kept, so a single Model can serve many boards of the same size.
+void Model::loadBoard(const std::string& board)
+{
+    currentBoard = board;
+    currentPivotIndex = static_cast<int>(board.find(static_cast<char>('a' + n * n - 1)));
+    solutionSteps.clear();
+}
+
 // Initializes the board state at the solution to ensure the board will be solvable.
 void Model::initializeBoard()
 {
@@ -31,11 +54,10 @@ void Model::randomizeBoard()
     std::random_device randomDevice;
     std::mt19937 mersenneTwisterEngine(randomDevice());
     // Will randomize the board starting from the solution to ensure the puzzle is solvable.
-    generateValidNeighbors();
     // Randomly moving 250 times from the solution to begin.
     for(int i = 0; i < 250; i++)
     {
-        std::vector<int> possibleSwaps = validNeighbors[currentPivotIndex];
+        std::vector<int> possibleSwaps = tables->validNeighbors[currentPivotIndex];
         const int range = static_cast<int>(possibleSwaps.size());
         std::uniform_int_distribution distribution(0, range - 1);
         const int randomNumber = distribution(mersenneTwisterEngine);
@@ -46,8 +68,9 @@ void Model::randomizeBoard()
 }
 
 // Generates all valid indexed moves for a pivot index and stores it in validNeighbors.
-void Model::generateValidNeighbors()
+void ModelTables::generateValidNeighbors()
 {
+    validNeighbors.resize(n * n);
     for(int i = 0; i < n * n; i++)
     {
         if(i - n >= 0)
@@ -71,18 +94,18 @@ void Model::generateValidNeighbors()
  * md = abs(targetRow - currentRow) + abs(targetColumn - currentColumn)
  * That is, the distance between two tiles when only horizontal and vertical movements are permitted.
  */
-void Model::precomputeManhattanDistances()
+void ModelTables::precomputeManhattanDistances()
 {
+    manhattanDistances.assign(n * n * n * n, 0);
     for(int i = 0; i < n * n; i++)
     {
-        manhattanDistances[i] = std::vector<int>(n * n);
         const int currentRow = i / n;
         const int currentColumn = i % n;
         for(int j = 0; j < n * n; j++)
         {
             const int targetRow = j / n;
             const int targetColumn = j % n;
-            manhattanDistances[i][j] = abs(targetRow - currentRow) + abs(targetColumn - currentColumn);
+            manhattanDistances[i * n * n + j] = abs(targetRow - currentRow) + abs(targetColumn - currentColumn);
         }
     }
 }
@@ -92,18 +115,18 @@ void Model::precomputeManhattanDistances()
  * cd = std::max(abs(targetRow - currentRow), abs(targetColumn - currentColumn))
  * That is, the larger of the vertical and horizontal distances between two tiles.
  */
-void Model::precomputeChebyshevDistances()
+void ModelTables::precomputeChebyshevDistances()
 {
+    chebyshevDistances.assign(n * n * n * n, 0);
     for(int i = 0; i < n * n; i++)
     {
-        chebyshevDistances[i] = std::vector<int>(n * n);
         const int currentRow = i / n;
         const int currentColumn = i % n;
         for(int j = 0; j < n * n; j++)
         {
             const int targetRow = j / n;
             const int targetColumn = j % n;
-            chebyshevDistances[i][j] = std::max(abs(targetRow - currentRow), abs(targetColumn - currentColumn));
+            chebyshevDistances[i * n * n + j] = std::max(abs(targetRow - currentRow), abs(targetColumn - currentColumn));
         }
     }
 }
@@ -112,14 +135,14 @@ void Model::precomputeChebyshevDistances()
 // Output: The Manhattan distance from starting tile to target tile.
 int Model::getManhattanDistance(const int& startIndex, const int& targetIndex)
 {
-    return manhattanDistances[startIndex][targetIndex];
+    return tables->manhattanDistances[startIndex * n * n + targetIndex];
 }
 
 // Input: The starting index of the tile to be checked and the target index of destination/goal tile.
 // Output: The Chebyshev distance from starting tile to target tile.
 int Model::getChebyshevDistance(const int& startIndex, const int& targetIndex)
 {
-    return chebyshevDistances[startIndex][targetIndex];
+    return tables->chebyshevDistances[startIndex * n * n + targetIndex];
 }
 
 /*
@@ -252,7 +275,12 @@ int Model::getPivotIndex() const
 
 std::vector<int> Model::getValidNeighbors(const int& index)
 {
-    return validNeighbors[index];
+    return tables->validNeighbors[index];
+}
+
+const MovePruningAutomaton& Model::getMovePruning() const
+{
+    return tables->movePruning;
 }
 
 void Model::updateBoard(const std::string& newBoard)
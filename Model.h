@@ -2,14 +2,34 @@
 #define MODEL_H
 #include <unordered_map>
 #include <iostream>
+#include <cmath>
 #include <string>
 #include <random>
 #include <vector>
+#include <memory>
+#include "MovePruning.h"
+
+// The precomputed tables for one board size. They are never modified once built, so every Model of that size can share one instance.
+struct ModelTables
+{
+    explicit ModelTables(const int& n);
+    int n;                                                              // Represents the dimension of the grid (n * n).
+    std::vector<std::vector<int>> validNeighbors;                       // validNeighbors[i] holds all valid neighboring indices of the pivot index i.
+    std::vector<int> manhattanDistances;                                // Flattened table of md's where entry [i * n * n + j] represents the md from the ith tile to the jth tile.
+    std::vector<int> chebyshevDistances;                                // Flattened table of cd's where entry [i * n * n + j] represents the cd from the ith tile to the jth tile.
+    MovePruningAutomaton movePruning;                                   // Rejects redundant move sequences (e.g. a move followed by its inverse) during search.
+private:
+    void generateValidNeighbors();
+    void precomputeManhattanDistances();
+    void precomputeChebyshevDistances();
+};
 
 class Model
 {
 public:
     Model();
+    explicit Model(const std::string& board);
+    Model(std::shared_ptr<const ModelTables> tables, const std::string& board);
 
     int getHorizontalLinearConflict(const std::string& elements, const int& currentRow) const;
     int getVerticalLinearConflict(const std::string& elements, const int& currentCol) const;
@@ -17,12 +37,14 @@ public:
     int getChebyshevDistance(const int& startIndex, const int& targetIndex);
 
     std::vector<int> getValidNeighbors(const int& index);
+    const MovePruningAutomaton& getMovePruning() const;
     const std::vector<int>& getSolutionSteps() const;
     const std::string& getCurrentBoard() const;
     const std::string& getSolution() const;
     int getPivotIndex() const;
     int getN() const;
 
+    void loadBoard(const std::string& board);
     void updateBoard(const std::string& newBoard);
     void updatePivotIndex(const int& newIndex);
     void addSolutionStep(const int& step);
@@ -33,14 +55,9 @@ private:
     std::string currentBoard;   // Represents the current board state; Use strings to flatten the array of integers; Works for up to 5x5 boards.
     std::string solution;       // Represents the solution board (goal state).
 
-    std::unordered_map<int, std::vector<int>> validNeighbors;           // Maps a specific pivot index to all its valid neighboring indices.
-    std::unordered_map<int, std::vector<int>> manhattanDistances;       // Array containing md's where array[i] represents the tile's md from the ith tile.
-    std::unordered_map<int, std::vector<int>> chebyshevDistances;       // Array containing cd's where array[i] represents the tile's cd from the ith tile.
+    std::shared_ptr<const ModelTables> tables;                          // Possibly shared with other Models of the same size.
     std::vector<int> solutionSteps;                                     // Vector of integers represents the tile being swapped with.
 
-    void generateValidNeighbors();
-    void precomputeManhattanDistances();
-    void precomputeChebyshevDistances();
     void initializeBoard();
     void randomizeBoard();
 };
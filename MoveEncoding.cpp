@@ -0,0 +1,110 @@
+#include "MoveEncoding.h"
+
+/*
+ * Input: The starting board, the pivot indices visited by the empty space (as stored in Model's solutionSteps), and the dimension of the board.
+ * Output: The solution packed at 2 bits per move. The solution ends before the first pair of pivots that are not adjacent, as that pair is not a move,
+ * so the verifier rejects it as not solving the board.
+ */
+EncodedSolution EncodedSolution::encode(const std::string& board, const std::vector<int>& pivots, const int& n)
+{
+    EncodedSolution solution;
+    solution.boardHash = hashBoard(board);
+    const uint32_t pivotMoves = pivots.empty() ? 0 : static_cast<uint32_t>(pivots.size() - 1);
+    solution.packedMoves.assign((pivotMoves + 3) / 4, 0);
+    for(uint32_t i = 0; i < pivotMoves; i++)
+    {
+        const Move move = getMove(pivots[i], pivots[i + 1], n);
+        if(move == InvalidMove)
+            break;
+        solution.packedMoves[i / 4] |= move << (i % 4 * 2);
+        solution.moveCount++;
+    }
+    solution.packedMoves.resize((solution.moveCount + 3) / 4);
+    return solution;
+}
+
+uint64_t EncodedSolution::hashBoard(const std::string& board)
+{
+    return hashBoard(board.data(), board.size());
+}
+
+// FNV-1a, 64-bit, over the board in Model's format.
+uint64_t EncodedSolution::hashBoard(const char* board, const size_t& size)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for(size_t i = 0; i < size; i++)
+    {
+        hash ^= static_cast<uint8_t>(board[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Input: Two pivot indices and the dimension of the board.
+// Output: The move that takes the empty space from the first index to the second, or InvalidMove if the indices are not adjacent.
+Move EncodedSolution::getMove(const int& fromPivot, const int& toPivot, const int& n)
+{
+    if(toPivot == fromPivot - n && toPivot >= 0)
+        return Up;
+    if(toPivot == fromPivot + n && toPivot < n * n)
+        return Down;
+    if(toPivot == fromPivot - 1 && fromPivot % n != 0)
+        return Left;
+    if(toPivot == fromPivot + 1 && toPivot % n != 0)
+        return Right;
+    return InvalidMove;
+}
+
+Move EncodedSolution::getMove(const uint32_t& index) const
+{
+    return static_cast<Move>(packedMoves[index / 4] >> (index % 4 * 2) & 3);
+}
+
+// Expands the moves back into pivot indices, the format used by Model and SlidingPuzzleApp.
+std::vector<int> EncodedSolution::decode(const int& startingPivot, const int& n) const
+{
+    const int offsets[4] = {-n, n, -1, 1};
+    std::vector<int> pivots = {startingPivot};
+    pivots.reserve(moveCount + 1);
+    for(uint32_t i = 0; i < moveCount; i++)
+        pivots.push_back(pivots.back() + offsets[getMove(i)]);
+    return pivots;
+}
+
+void EncodedSolution::serialize(std::string& buffer) const
+{
+    appendLittleEndian(buffer, boardHash, sizeof(boardHash));
+    appendLittleEndian(buffer, moveCount, sizeof(moveCount));
+    buffer.append(reinterpret_cast<const char*>(packedMoves.data()), packedMoves.size());
+}
+
+// Reads one solution and advances data past it. Returns false if the buffer ends before the solution does.
+bool EncodedSolution::deserialize(const uint8_t*& data, const uint8_t* end, EncodedSolution& solution)
+{
+    if(end - data < static_cast<long>(sizeof(boardHash) + sizeof(moveCount)))
+        return false;
+    solution.boardHash = readLittleEndian(data, sizeof(boardHash));
+    solution.moveCount = static_cast<uint32_t>(readLittleEndian(data + sizeof(boardHash), sizeof(moveCount)));
+    const size_t packedSize = (static_cast<size_t>(solution.moveCount) + 3) / 4;
+    data += sizeof(boardHash) + sizeof(moveCount);
+    if(static_cast<size_t>(end - data) < packedSize)
+        return false;
+    solution.packedMoves.assign(data, data + packedSize);
+    data += packedSize;
+    return true;
+}
+
+// Appends the lowest byteCount bytes of the value, least significant first. The serialized formats use this byte order on every host.
+void EncodedSolution::appendLittleEndian(std::string& buffer, const uint64_t& value, const size_t& byteCount)
+{
+    for(size_t i = 0; i < byteCount; i++)
+        buffer += static_cast<char>(value >> (i * 8) & 0xFF);
+}
+
+uint64_t EncodedSolution::readLittleEndian(const uint8_t* data, const size_t& byteCount)
+{
+    uint64_t value = 0;
+    for(size_t i = 0; i < byteCount; i++)
+        value |= static_cast<uint64_t>(data[i]) << (i * 8);
+    return value;
+}
\ No newline at end of file
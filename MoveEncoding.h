@@ -0,0 +1,40 @@
+#ifndef MOVEENCODING_H
+#define MOVEENCODING_H
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// The direction the empty space moves in. Fits in 2 bits.
+enum Move : uint8_t
+{
+    Up = 0,
+    Down = 1,
+    Left = 2,
+    Right = 3,
+    InvalidMove = 4     // Returned by getMove for two pivots that are not adjacent. Never packed.
+};
+
+/*
+ * A solution stored as 2 bits per move, four moves per byte with the first move in the lowest bits.
+ * The hash identifies the starting board so a solution cannot be replayed against the wrong board by mistake.
+ * Serialized as: uint64 boardHash, uint32 moveCount, then (moveCount + 3) / 4 bytes of packed moves. Integers are little-endian on every host.
+ */
+struct EncodedSolution
+{
+    uint64_t boardHash{};
+    uint32_t moveCount{};
+    std::vector<uint8_t> packedMoves;
+
+    static EncodedSolution encode(const std::string& board, const std::vector<int>& pivots, const int& n);
+    static uint64_t hashBoard(const std::string& board);
+    static uint64_t hashBoard(const char* board, const size_t& size);
+    static Move getMove(const int& fromPivot, const int& toPivot, const int& n);
+    [[nodiscard]] Move getMove(const uint32_t& index) const;
+    [[nodiscard]] std::vector<int> decode(const int& startingPivot, const int& n) const;
+    void serialize(std::string& buffer) const;
+    static bool deserialize(const uint8_t*& data, const uint8_t* end, EncodedSolution& solution);
+    static void appendLittleEndian(std::string& buffer, const uint64_t& value, const size_t& byteCount);
+    static uint64_t readLittleEndian(const uint8_t* data, const size_t& byteCount);
+};
+
+#endif //MOVEENCODING_H
\ No newline at end of file
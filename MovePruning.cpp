@@ -0,0 +1,158 @@
+#include "MovePruning.h"
+#include <algorithm>
+#include <queue>
+#include <map>
+
+namespace
+{
+    const std::string moveNames = "UDLR";
+}
+
+MovePruningAutomaton::MovePruningAutomaton(const int& maxDepth)
+{
+    findRedundantSequences(maxDepth);
+    buildAutomaton();
+}
+
+/*
+ * Enumerates move sequences breadth-first, in move order, on an open board large enough that no sequence reaches an edge.
+ * Sequences that already end in a known redundant sequence are skipped, so only the shortest redundant sequences are recorded.
+ * A sequence is only recorded if the squares visited by the earlier sequence are a subset of its own. Wherever the redundant sequence can be played
+ * (on a board with edges and locked tiles), the earlier one can then be played too, so pruning never removes the only way to reach a board.
+ */
+void MovePruningAutomaton::findRedundantSequences(const int& maxDepth)
+{
+    const int size = 2 * maxDepth + 1;
+    const int offsets[4] = {-size, size, -1, 1};
+    std::vector<int> startingBoard(size * size);
+    for(int i = 0; i < size * size; i++)
+        startingBoard[i] = i;
+
+    struct Sequence
+    {
+        std::string moves;
+        std::vector<int> board;
+        std::vector<bool> visited;
+        int pivot;
+    };
+    Sequence start{"", startingBoard, std::vector<bool>(size * size, false), size * size / 2};
+    start.visited[start.pivot] = true;
+    // Maps each board to the squares visited by the first sequence that reached it.
+    std::map<std::vector<int>, std::vector<bool>> reachedBoards = {{start.board, start.visited}};
+    std::vector<Sequence> frontier = {start};
+    for(int depth = 1; depth <= maxDepth; depth++)
+    {
+        std::vector<Sequence> nextFrontier;
+        for(const auto& sequence : frontier)
+        {
+            for(int move = 0; move < 4; move++)
+            {
+                const std::string moves = sequence.moves + moveNames[move];
+                const bool endsInRedundantSequence = std::any_of(redundantSequences.begin(), redundantSequences.end(), [&moves](const std::string& redundantSequence)
+                {
+                    return moves.size() >= redundantSequence.size() && moves.compare(moves.size() - redundantSequence.size(), redundantSequence.size(), redundantSequence) == 0;
+                });
+                if(endsInRedundantSequence)
+                    continue;
+                Sequence next{moves, sequence.board, sequence.visited, sequence.pivot + offsets[move]};
+                std::swap(next.board[sequence.pivot], next.board[next.pivot]);
+                next.visited[next.pivot] = true;
+                const auto [reachedBoard, isNewBoard] = reachedBoards.emplace(next.board, next.visited);
+                bool isRedundant = false;
+                if(!isNewBoard)
+                {
+                    isRedundant = true;
+                    for(int i = 0; i < size * size; i++)
+                    {
+                        if(reachedBoard->second[i] && !next.visited[i])
+                            isRedundant = false;
+                    }
+                }
+                if(isRedundant)
+                    redundantSequences.push_back(moves);
+                else
+                    nextFrontier.push_back(std::move(next));
+            }
+        }
+        frontier = std::move(nextFrontier);
+    }
+}
+
+// Builds an Aho-Corasick automaton over the redundant sequences. A state is pruned if the moves leading to it end in any redundant sequence.
+void MovePruningAutomaton::buildAutomaton()
+{
+    transitions = {{prunedState, prunedState, prunedState, prunedState}};
+    std::vector<bool> isPruned = {false};
+    for(const auto& sequence : redundantSequences)
+    {
+        int state = startState;
+        for(const char& c : sequence)
+        {
+            const int move = static_cast<int>(moveNames.find(c));
+            if(transitions[state][move] == prunedState)
+            {
+                transitions[state][move] = static_cast<int>(transitions.size());
+                transitions.push_back({prunedState, prunedState, prunedState, prunedState});
+                isPruned.push_back(false);
+            }
+            state = transitions[state][move];
+        }
+        isPruned[state] = true;
+    }
+
+    // Fill in the missing transitions from the failure links, breadth-first so every failure state is complete before it is used.
+    std::vector<int> failure(transitions.size(), startState);
+    std::queue<int> states;
+    for(int move = 0; move < 4; move++)
+    {
+        if(transitions[startState][move] == prunedState)
+            transitions[startState][move] = startState;
+        else
+            states.push(transitions[startState][move]);
+    }
+    while(!states.empty())
+    {
+        const int state = states.front();
+        states.pop();
+        if(isPruned[failure[state]])
+            isPruned[state] = true;
+        for(int move = 0; move < 4; move++)
+        {
+            const int next = transitions[state][move];
+            if(next == prunedState)
+                transitions[state][move] = transitions[failure[state]][move];
+            else
+            {
+                failure[next] = transitions[failure[state]][move];
+                states.push(next);
+            }
+        }
+    }
+
+    // Pruned states are never entered, so transitions into them are replaced by prunedState.
+    for(auto& stateTransitions : transitions)
+    {
+        for(auto& next : stateTransitions)
+        {
+            if(isPruned[next])
+                next = prunedState;
+        }
+    }
+}
+
+// Input: The automaton state of the parent node and the move leading to the child.
+// Output: The automaton state of the child, or prunedState if the child is redundant.
+int MovePruningAutomaton::transition(const int& state, const Move& move) const
+{
+    return transitions[state][move];
+}
+
+int MovePruningAutomaton::getStateCount() const
+{
+    return static_cast<int>(transitions.size());
+}
+
+const std::vector<std::string>& MovePruningAutomaton::getRedundantSequences() const
+{
+    return redundantSequences;
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#ifndef MOVEPRUNING_H
+#define MOVEPRUNING_H
+#include "MoveEncoding.h"
+#include <array>
+
+/*
+ * A finite-state automaton over moves of the empty space that rejects redundant move sequences, such as a move followed by its inverse.
+ * At construction, every move sequence up to maxDepth is applied to an open board. A sequence is redundant if it reaches a board that a shorter
+ * (or equally long but lexicographically smaller) sequence already reached; the shortest such sequences are compiled into an Aho-Corasick automaton.
+ * Searches keep one automaton state per node and skip any move whose transition is pruned, so duplicates are never generated.
+ * Depth 2 (inverse pairs) is always safe alongside duplicate detection, which is why it is the default used by aStar. Deeper automata also prune
+ * equal-length transpositions (e.g. the two directions around a 2x2 block) and are meant for depth-first searches that have no visited table.
+ */
+class MovePruningAutomaton
+{
+public:
+    explicit MovePruningAutomaton(const int& maxDepth = 2);
+    static constexpr int startState = 0;
+    static constexpr int prunedState = -1;
+    [[nodiscard]] int transition(const int& state, const Move& move) const;
+    [[nodiscard]] int getStateCount() const;
+    [[nodiscard]] const std::vector<std::string>& getRedundantSequences() const;
+private:
+    std::vector<std::array<int, 4>> transitions;    // transitions[state][move] is the next state, or prunedState.
+    std::vector<std::string> redundantSequences;    // The shortest redundant sequences, written with the characters "UDLR".
+
+    void findRedundantSequences(const int& maxDepth);
+    void buildAutomaton();
+};
+
+#endif //MOVEPRUNING_H
\ No newline at end of file
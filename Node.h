@@ -22,6 +22,8 @@ struct Node
     std::string state;
     // Nodes hold the previous pivot indices representing their path in a stack.
     std::stack<int> path;
+    // The state of the move-pruning automaton after the moves in path.
+    int pruningState{};
 };
 
 #endif //NODE_H
\ No newline at end of file
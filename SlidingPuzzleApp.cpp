@@ -1,7 +1,7 @@
 #include "SlidingPuzzleApp.h"
 
 // Make sure manually change the dimensions of sf::VideoMode based on the chosen n.
-SlidingPuzzleApp::SlidingPuzzleApp() : Application(sf::VideoMode({240, 240}, 32), "Sliding Puzzle App", *this)
+SlidingPuzzleApp::SlidingPuzzleApp(const bool& realTime) : Application(sf::VideoMode({240, 240}, 32), "Sliding Puzzle App", *this), realTime(realTime)
 {
     n = model.getN();
     if(n == 3)
@@ -52,34 +52,69 @@ void SlidingPuzzleApp::initialization()
         for(auto& gridBox : row)
             addComponent(gridBox);
 
-    SlidingPuzzleSolver solver(model);
-    solver.solve();
-    solutionSteps = model.getSolutionSteps();
+    // In real-time mode there is no offline solve; each update below searches for one move within its budget.
+    if(!realTime)
+    {
+        if(!solver.solve())
+        {
+            isFinished = true;
+            std::cout << "No solution found. States explored: " << solver.getStatesExplored() << '\n';
+            return;
+        }
+        solutionSteps = model.getSolutionSteps();
+        std::cout << "Steps to solution: " << solutionSteps.size() << '\n';
+        std::cout << "States explored: " << solver.getStatesExplored();
+    }
 
     onUpdate([this]()
     {
-        if(currentStep >= solutionSteps.size() - 1)
-           return;
-        if(clock.getElapsedTime().asSeconds() >= delay)
+        if(isFinished || clock.getElapsedTime().asSeconds() < delay)
+            return;
+        if(realTime)
         {
-            const int startingTileIndex = solutionSteps[currentStep];
-            const int startingTileRow = startingTileIndex / n;
-            const int startingTileColumn = startingTileIndex % n;
-            const int nextTileIndex = solutionSteps[currentStep + 1];
-            const int nextTileRow = nextTileIndex / n;
-            const int nextTileColumn = nextTileIndex % n;
-            const sf::Vector2f startingPosition = grid[startingTileRow][startingTileColumn].getPosition();
-            const sf::Vector2f nextPosition = grid[nextTileRow][nextTileColumn].getPosition();
-            grid[startingTileRow][startingTileColumn].setPosition(nextPosition);
-            grid[nextTileRow][nextTileColumn].setPosition(startingPosition);
-            std::swap(grid[startingTileRow][startingTileColumn], grid[nextTileRow][nextTileColumn]);
+            const int startingTileIndex = model.getPivotIndex();
+            const int nextTileIndex = solver.realTimeStep(expansionBudget, timeBudget);
+            if(nextTileIndex == SlidingPuzzleSolver::noMoveStep)
+            {
+                isFinished = true;
+                std::cout << "Real-time search found no move after " << model.getSolutionSteps().size() << " steps. States explored: " << solver.getStatesExplored() << '\n';
+                return;
+            }
+            if(nextTileIndex == SlidingPuzzleSolver::solvedStep)
+            {
+                isFinished = true;
+                std::cout << "Steps to solution: " << model.getSolutionSteps().size() << '\n';
+                std::cout << "States explored: " << solver.getStatesExplored();
+                return;
+            }
+            swapTiles(startingTileIndex, nextTileIndex);
+        }
+        else
+        {
+            if(currentStep >= static_cast<int>(solutionSteps.size()) - 1)
+            {
+                isFinished = true;
+                return;
+            }
+            swapTiles(solutionSteps[currentStep], solutionSteps[currentStep + 1]);
             currentStep++;
-            clock.restart();
         }
+        clock.restart();
     });
+}
 
-    std::cout << "Steps to solution: " << solutionSteps.size() << '\n';
-    std::cout << "States explored: " << solver.getStatesExplored();
+// Swaps the grid boxes at the two indices, moving the empty space from the first index to the second.
+void SlidingPuzzleApp::swapTiles(const int& startingTileIndex, const int& nextTileIndex)
+{
+    const int startingTileRow = startingTileIndex / n;
+    const int startingTileColumn = startingTileIndex % n;
+    const int nextTileRow = nextTileIndex / n;
+    const int nextTileColumn = nextTileIndex % n;
+    const sf::Vector2f startingPosition = grid[startingTileRow][startingTileColumn].getPosition();
+    const sf::Vector2f nextPosition = grid[nextTileRow][nextTileColumn].getPosition();
+    grid[startingTileRow][startingTileColumn].setPosition(nextPosition);
+    grid[nextTileRow][nextTileColumn].setPosition(startingPosition);
+    std::swap(grid[startingTileRow][startingTileColumn], grid[nextTileRow][nextTileColumn]);
 }
 
 void SlidingPuzzleApp::registerEvents() {}
\ No newline at end of file
@@ -8,19 +8,26 @@
 class SlidingPuzzleApp final : public ml::Application
 {
 public:
-    SlidingPuzzleApp();
+    explicit SlidingPuzzleApp(const bool& realTime = false);
     void initialization() override;
     void registerEvents() override;
 private:
+    void swapTiles(const int& startingTileIndex, const int& nextTileIndex);
+
     std::vector<std::vector<ml::RectangleButton>> grid;
     std::vector<int> solutionSteps;
     std::string imagePath;
     sf::Texture texture;
     int currentStep = 0;
     float delay = 0.25f;
+    bool realTime;                  // If true, moves are found by the solver's real-time search during playback instead of by an offline solve.
+    int expansionBudget = 300;      // The lookahead budget of each real-time step, in expansions.
+    std::chrono::microseconds timeBudget{50000};    // The lookahead budget of each real-time step, in time. Kept well under delay so playback never stalls.
+    bool isFinished = false;
     float dimensions;
     sf::Clock clock;
     Model model;
+    SlidingPuzzleSolver solver{model};
     int n;
 };
 
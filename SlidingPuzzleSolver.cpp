@@ -1,9 +1,7 @@
 #include "SlidingPuzzleSolver.h"
 
-SlidingPuzzleSolver::SlidingPuzzleSolver(Model& model) : model(model), statesExplored(0)
+SlidingPuzzleSolver::SlidingPuzzleSolver(Model& model) : statesExplored(0), n(model.getN()), model(model), deadline(std::chrono::steady_clock::time_point::max()), cache(nullptr), stateLimit(SIZE_MAX), isStateLimitReached(false), realTimeSubGoalIndex(-1)
 {
-    n = model.getN();
-    currentBoardN = n;
     generateSubGoals();
 }
 
@@ -17,7 +15,7 @@ void SlidingPuzzleSolver::generateSubGoals()
     {
         // Breaking the problem into parts. This is good for space complexity but does not guarantee a solution.
         // The reason why this method does not guarantee a solution is that the tiles are locked in place once in their positions.
-        // Hence, the parity of the remaining board may also be locked in place, leading to an unresolvable n x n sub-board.
+        // The remaining board always keeps a solvable parity (see isSolvable), but the search may run out of memory resolving the conflicts left around the locked tiles.
         const SubGoal fiveByFiveSubGoalOne({currentRow * n + currentColumn});
         subGoals.push_back(fiveByFiveSubGoalOne);
 
@@ -97,22 +95,213 @@ void SlidingPuzzleSolver::generateSubGoals()
     // Note: We could consider making sub-goals for 3x3 and then 2x2 but at this stage in the puzzle, guaranteeing the remaining puzzle can be solved is more important as computations are orders of magnitude cheaper.
 }
 
-void SlidingPuzzleSolver::solve()
+// Returns true if the board was solved. Returns false if the board is unsolvable or a sub-goal could not be reached, either because the heap was exhausted,
+// the deadline passed, or the state limit was reached.
+bool SlidingPuzzleSolver::solve()
 {
+    // Start from the current board, even if solve() or realTimeStep() has already been called.
+    lockedTiles.clear();
+    isStateLimitReached = false;
+    // Parity is invariant under moves, so an unsolvable board stays unsolvable after any placement of the sub-goals' tiles.
+    // Rejecting it here avoids searching until the heap is exhausted.
+    if(!isSolvable(model.getCurrentBoard()))
+        return false;
     // Iterate through the sub-goals.
     for(const auto& subGoal : subGoals)
     {
-        // Call aStar on sub-goal. aStar will verify that the remaining board is solvable if the goal state's isEndingSequence is set to true.
-        aStar(subGoal);
+        // Serve the sub-goal from the cache if it has been solved before from this exact board.
+        uint64_t cacheKey = 0;
+        std::vector<int> cachedPivots;
+        if(cache != nullptr)
+            cacheKey = cache->getKey(model.getCurrentBoard(), lockedTiles, subGoal);
+        const bool isCached = cache != nullptr && cache->lookup(cacheKey, cachedPivots) && applyCachedSteps(cachedPivots, subGoal);
+        if(cache != nullptr)
+            cache->countLookup(isCached);
+        if(!isCached)
+        {
+            const size_t firstStep = model.getSolutionSteps().size();
+            // Call aStar on sub-goal.
+            if(!aStar(subGoal))
+                return false;
+            if(cache != nullptr)
+            {
+                std::vector<int> pivots(model.getSolutionSteps().begin() + static_cast<long>(firstStep), model.getSolutionSteps().end());
+                pivots.push_back(model.getPivotIndex());
+                cache->store(cacheKey, pivots);
+            }
+        }
         // Then lock the tiles.
         for(const auto& targetTileNumber : subGoal.targetTileNumbers)
             lockedTiles.insert(targetTileNumber);
     }
     // Add the final movement to the path.
     model.addSolutionStep(model.getPivotIndex());
+    return true;
+}
+
+/*
+ * Real-time search in the style of RTAA*. Each call runs A* from the current board for at most expansionBudget expansions (and timeBudget, if set),
+ * commits the first move towards the best frontier node, and raises the learned h-values of the expanded states to f(best) - g(state).
+ * The learned values stop the search from cycling, so repeated calls reach each sub-goal without an offline solve.
+ * Memory is constant: the lookahead is bounded by the budget and the learned values live in a fixed-size table.
+ * Sub-goals are worked through in the same order as solve(), locking their tiles once reached. The locked tiles are kept apart from solve()'s,
+ * so calling solve() part way through a real-time solution finishes it from the current board.
+ * Output: The index the empty space moved to, solvedStep once the board is solved, or noMoveStep if the board is unsolvable or no move was found.
+ */
+int SlidingPuzzleSolver::realTimeStep(const int& expansionBudget, const std::chrono::microseconds& timeBudget)
+{
+    const auto stepDeadline = timeBudget > std::chrono::microseconds::zero() ? std::chrono::steady_clock::now() + timeBudget : std::chrono::steady_clock::time_point::max();
+    // The first step proves the board solvable, exactly as solve() does.
+    if(realTimeSubGoalIndex < 0)
+    {
+        if(!isSolvable(model.getCurrentBoard()))
+            return noMoveStep;
+        realTimeSubGoalIndex = 0;
+        // 2^18 entries (4 MB) hold the learned values of thousands of steps while keeping memory constant.
+        learnedHeuristics.assign(1 << 18, {0, -1});
+    }
+
+    // Lock every sub-goal the current board has reached.
+    const int subGoalCount = static_cast<int>(subGoals.size());
+    while(realTimeSubGoalIndex < subGoalCount && isSubGoalReached(model.getCurrentBoard(), subGoals[realTimeSubGoalIndex]))
+    {
+        const SubGoal& subGoal = subGoals[realTimeSubGoalIndex++];
+        for(const auto& targetTileNumber : subGoal.targetTileNumbers)
+            realTimeLockedTiles.insert(targetTileNumber);
+        // Add the final movement to the path.
+        if(realTimeSubGoalIndex == subGoalCount)
+            model.addSolutionStep(model.getPivotIndex());
+    }
+    if(realTimeSubGoalIndex >= subGoalCount)
+        return solvedStep;
+
+    // Bounded lookahead. The search stops at the first goal node or when the budget runs out; either way the top of the heap is the best frontier node.
+    const SubGoal& goalState = subGoals[realTimeSubGoalIndex];
+    const MovePruningAutomaton& movePruning = model.getMovePruning();
+    std::priority_queue<Node, std::vector<Node>, CompareNodes> frontier;
+    std::unordered_map<std::string, int> lowestG;               // The lowest g-value found for each state in this lookahead.
+    std::vector<std::pair<std::string, int>> expandedStates;    // The expanded states and their g-values, for the learning update.
+    const std::string& currentBoard = model.getCurrentBoard();
+    lowestG[currentBoard] = 0;
+    frontier.emplace(currentBoard, model.getPivotIndex(), 0, getLearnedHeuristic(currentBoard, goalState));
+    while(!frontier.empty())
+    {
+        const Node& topNode = frontier.top();
+        // Skip entries superseded by a cheaper path to the same state.
+        if(topNode.g > lowestG[topNode.state])
+        {
+            frontier.pop();
+            continue;
+        }
+        if((topNode.g > 0 && isSubGoalReached(topNode.state, goalState)) || static_cast<int>(expandedStates.size()) >= std::max(expansionBudget, 1)
+            || (stepDeadline != std::chrono::steady_clock::time_point::max() && !expandedStates.empty() && std::chrono::steady_clock::now() > stepDeadline))
+            break;
+        Node currentNode = topNode;
+        frontier.pop();
+        expandedStates.emplace_back(currentNode.state, currentNode.g);
+        for(const auto& neighbor : model.getValidNeighbors(currentNode.pivotSquare))
+        {
+            const int pruningState = movePruning.transition(currentNode.pruningState, EncodedSolution::getMove(currentNode.pivotSquare, neighbor, n));
+            if(pruningState == MovePruningAutomaton::prunedState || realTimeLockedTiles.find(neighbor) != realTimeLockedTiles.end())
+                continue;
+            std::string currentState = currentNode.state;
+            std::swap(currentState[currentNode.pivotSquare], currentState[neighbor]);
+            const auto lowestGOfState = lowestG.find(currentState);
+            if(lowestGOfState != lowestG.end() && lowestGOfState->second <= currentNode.g + 1)
+                continue;
+            statesExplored++;
+            lowestG[currentState] = currentNode.g + 1;
+            Node newNode(currentState, neighbor, currentNode.path, currentNode.g + 1, getLearnedHeuristic(currentState, goalState));
+            newNode.pruningState = pruningState;
+            newNode.path.push(currentNode.pivotSquare);
+            frontier.push(newNode);
+        }
+    }
+    // The lookahead ran out of states before its budget, so no move from the current board can reach the sub-goal.
+    if(frontier.empty())
+        return noMoveStep;
+    const Node& bestNode = frontier.top();
+
+    // Learning: every expanded state is at least as far from the goal as the best frontier node's f-value implies.
+    // Only raised values are stored, which keeps the fixed-size table from filling with values getHeuristic already returns.
+    for(const auto& [state, g] : expandedStates)
+    {
+        if(bestNode.f() - g <= getLearnedHeuristic(state, goalState))
+            continue;
+        const size_t stateHash = getLearnedHeuristicKey(state);
+        learnedHeuristics[stateHash % learnedHeuristics.size()] = {stateHash, bestNode.f() - g};
+    }
+
+    // Commit only the first move on the path to the best frontier node. The bottom of the path is the current pivot.
+    std::stack<int> path = bestNode.path;
+    int nextPivotIndex = bestNode.pivotSquare;
+    while(path.size() > 1)
+    {
+        nextPivotIndex = path.top();
+        path.pop();
+    }
+    const int pivotIndex = model.getPivotIndex();
+    std::string board = model.getCurrentBoard();
+    std::swap(board[pivotIndex], board[nextPivotIndex]);
+    model.addSolutionStep(pivotIndex);
+    model.updateBoard(board);
+    model.updatePivotIndex(nextPivotIndex);
+    return nextPivotIndex;
+}
+
+// Bounds the time spent by solve(). The deadline is checked periodically inside aStar.
+void SlidingPuzzleSolver::setDeadline(const std::chrono::steady_clock::time_point& newDeadline)
+{
+    deadline = newDeadline;
+}
+
+// Bounds the memory used by solve(). A sub-goal search that stores more than limit states gives up, and hasReachedStateLimit() then returns true.
+void SlidingPuzzleSolver::setStateLimit(const size_t& limit)
+{
+    stateLimit = limit;
+}
+
+bool SlidingPuzzleSolver::hasReachedStateLimit() const
+{
+    return isStateLimitReached;
+}
+
+// Uses the given cache. Pass nullptr to disable caching.
+void SlidingPuzzleSolver::setCache(SubGoalCache* newCache)
+{
+    cache = newCache;
+}
+
+/*
+ * Replays cached pivots on the current board. The replay is checked move by move, so a hash collision or a corrupted cache file can never produce an illegal solution.
+ * Input: The pivot indices from the cache and the sub-goal they are supposed to reach.
+ * Output: True if the pivots were applied. The model is left untouched otherwise.
+ */
+bool SlidingPuzzleSolver::applyCachedSteps(const std::vector<int>& pivots, const SubGoal& goalState)
+{
+    if(pivots.empty() || pivots.front() != model.getPivotIndex())
+        return false;
+    std::string board = model.getCurrentBoard();
+    for(int i = 0; i + 1 < static_cast<int>(pivots.size()); i++)
+    {
+        const std::vector<int> validNeighborIndices = model.getValidNeighbors(pivots[i]);
+        if(std::find(validNeighborIndices.begin(), validNeighborIndices.end(), pivots[i + 1]) == validNeighborIndices.end() || lockedTiles.count(pivots[i + 1]) > 0)
+            return false;
+        std::swap(board[pivots[i]], board[pivots[i + 1]]);
+    }
+    for(const auto& targetTileNumber : goalState.targetTileNumbers)
+    {
+        if(board[targetTileNumber] - 'a' != targetTileNumber)
+            return false;
+    }
+    for(int i = 0; i + 1 < static_cast<int>(pivots.size()); i++)
+        model.addSolutionStep(pivots[i]);
+    model.updateBoard(board);
+    model.updatePivotIndex(pivots.back());
+    return true;
 }
 
-void SlidingPuzzleSolver::aStar(const SubGoal& goalState)
+bool SlidingPuzzleSolver::aStar(const SubGoal& goalState)
 {
     /*
      * Declare a priority queue, with lowest f(n) = g(n) + h(n) at the top.
@@ -124,81 +313,47 @@ void SlidingPuzzleSolver::aStar(const SubGoal& goalState)
     */
     std::priority_queue<Node, std::vector<Node>, CompareNodes> minHeap;
 
-    // Unordered map stores the states already visited in the current iteration/goal-step.
+    // Unordered map stores the states already visited in the current iteration/goal-step. stateLimit bounds its size, and with it the search's memory.
     std::unordered_map<std::string, Node> visitedStates;
 
     // Current board.
     std::string currentBoard = model.getCurrentBoard();
     // Current pivot index.
-    int pivotIndex = model.getPivotIndex();
+    const int pivotIndex = model.getPivotIndex();
 
     // Initialize starting node, add its state to the visited states, and add it to the priority queue.
-    Node startingNode(currentBoard, pivotIndex, 0, 0);
+    Node startingNode(currentBoard, pivotIndex, 0, getHeuristic(currentBoard, goalState));
     statesExplored++;
     visitedStates[currentBoard] = startingNode;
     minHeap.push(startingNode);
 
     // Traverse various states while the heap is not empty.
+    int expansions = 0;
     while(!minHeap.empty())
     {
-        // Retrieve the state with the lowest score and pop it.
-        Node currentNode = minHeap.top();
-        minHeap.pop();
+        // Reading the clock is not free, so the deadline is only checked every 64 expansions (tens of microseconds).
+        if(++expansions % 64 == 0 && std::chrono::steady_clock::now() > deadline)
+            return false;
+        if(visitedStates.size() > stateLimit)
+        {
+            isStateLimitReached = true;
+            return false;
+        }
+        Node currentNode = popBestNode(minHeap);
         // For every target placement and target tile number pair, check if it has been reached.
         for(int i = 0; i < goalState.targetTileNumbers.size(); i++)
         {
             // If the state has been reached, we continue.
             if(currentNode.state[goalState.targetTileNumbers[i]] - 'a' == goalState.targetTileNumbers[i])
             {
-                // If the final state is reached, we then check if the shrunken board is solvable if the current board is greater than a 3x3.
+                // If the final state is reached, the sub-goal is done. The remaining board needs no check: solvability is invariant under moves,
+                // and solve() proves it for the starting board before searching.
                 if(i == goalState.targetTileNumbers.size() - 1)
                 {
-                    // Otherwise, we simply store the steps and return.
-                    if(currentBoardN <= 3 || !goalState.isEndingSequence)
-                    {
-                        addSolutionSteps(currentNode);
-                        model.updateBoard(currentNode.state);
-                        model.updatePivotIndex(currentNode.pivotSquare);
-                        return;
-                    }
-                    else
-                    {
-                        // Flatten the remaining state, then pass it into the function.
-                        std::string remainingState;
-                        std::unordered_set<int> currentTiles;
-                        for(int targetTileNumber : goalState.targetTileNumbers)
-                        {
-                            currentTiles.insert(targetTileNumber);
-                        }
-                        for(const char& c : currentNode.state)
-                        {
-                            if(lockedTiles.find(c - 'a') == lockedTiles.end() && currentTiles.find(c - 'a') == currentTiles.end())
-                                remainingState += c;
-                        }
-                        // Odd and even boards have different checks.
-                        if(currentBoardN % 2 == 1)
-                        {
-                            if(isSolvableOdd(remainingState))
-                            {
-                                currentBoardN--;
-                                addSolutionSteps(currentNode);
-                                model.updateBoard(currentNode.state);
-                                model.updatePivotIndex(currentNode.pivotSquare);
-                                return;
-                            }
-                        }
-                        else
-                        {
-                            if(isSolvableEven(remainingState))
-                            {
-                                currentBoardN--;
-                                addSolutionSteps(currentNode);
-                                model.updateBoard(currentNode.state);
-                                model.updatePivotIndex(currentNode.pivotSquare);
-                                return;
-                            }
-                        }
-                    }
+                    addSolutionSteps(currentNode);
+                    model.updateBoard(currentNode.state);
+                    model.updatePivotIndex(currentNode.pivotSquare);
+                    return true;
                 }
             }
             // Otherwise, we break and move onto the next step.
@@ -209,99 +364,164 @@ void SlidingPuzzleSolver::aStar(const SubGoal& goalState)
         std::vector<int> validNeighborIndices = model.getValidNeighbors(currentNode.pivotSquare);
         for(const auto& neighbor : validNeighborIndices)
         {
-            if(lockedTiles.find(neighbor) == lockedTiles.end())
-            {
-                std::string currentState = currentNode.state;
-                pivotIndex = currentNode.pivotSquare;
-                std::swap(currentState[pivotIndex], currentState[neighbor]);
-                int heuristic = 0;
-
-                // The first heuristic: the Manhattan distance of the target tile from its target placement.
-                // Alternatively, Chebyshev distance can be used: https://www.researchgate.net/publication/301536229_A_Comparative_Study_of_Three_Heuristic_Functions_Used_to_Solve_the_8-Puzzle
-                for(int i = 0; i < goalState.targetTileNumbers.size(); i++)
-                {
-                    if(currentState[i] != 'a' + n * n - 1)
-                        heuristic += model.getChebyshevDistance(currentState.find('a' + goalState.targetTileNumbers[i]), goalState.targetTileNumbers[i]) * 2;
-                        // heuristic += model.getManhattanDistance(currentState.find('a' + goalState.targetTileNumbers[i]), goalState.targetTileNumbers[i]);
-                }
+            Node newNode;
+            if(generateChild(currentNode, neighbor, goalState, newNode))
+                storeChild(newNode, visitedStates, minHeap);
+        }
+    }
+    // The heap was exhausted without reaching the sub-goal.
+    return false;
+}
 
-                // The second heuristic: the total linear conflict of the remaining board.
-                for(int i = 0; i < n; i++)
-                {
-                    // Pass in the current row as a flattened string.
-                    heuristic += model.getHorizontalLinearConflict(currentState.substr(i * n, n), i);
-                    // Pass in the current column as a flattened string.
-                    std::string flattenedVertical;
-                    for(int j = 0; j < n; j++)
-                    {
-                        flattenedVertical += currentState[j * n + i];
-                    }
-                    heuristic += model.getVerticalLinearConflict(flattenedVertical, i);
-                }
+// Retrieves the state with the lowest score and pops it.
+Node SlidingPuzzleSolver::popBestNode(std::priority_queue<Node, std::vector<Node>, CompareNodes>& minHeap)
+{
+    Node node = minHeap.top();
+    minHeap.pop();
+    return node;
+}
 
-                // Initialize a new node with the same path, an incremented g-value, and the heuristic we just calculated.
-                Node newNode(currentState, neighbor, currentNode.path, currentNode.g + 1, heuristic);
+// Input: The node being expanded, the index of the tile to move into its empty space, and the sub-goal being searched for.
+// Output: False if the move is pruned or moves a locked tile. Otherwise, the child node is written into child.
+bool SlidingPuzzleSolver::generateChild(const Node& parent, const int& neighbor, const SubGoal& goalState, Node& child) const
+{
+    // Moves that would complete a redundant sequence (e.g. undoing the previous move) are skipped before the child is built.
+    const int pruningState = model.getMovePruning().transition(parent.pruningState, EncodedSolution::getMove(parent.pivotSquare, neighbor, n));
+    if(pruningState == MovePruningAutomaton::prunedState || lockedTiles.find(neighbor) != lockedTiles.end())
+        return false;
+    std::string currentState = parent.state;
+    std::swap(currentState[parent.pivotSquare], currentState[neighbor]);
+    const int heuristic = getHeuristic(currentState, goalState);
+
+    // Initialize a new node with the same path, an incremented g-value, and the heuristic we just calculated.
+    child = Node(std::move(currentState), neighbor, parent.path, parent.g + 1, heuristic);
+    // Insert the current pivot index in the path so we can re-trace it later.
+    child.path.push(parent.pivotSquare);
+    child.pruningState = pruningState;
+    return true;
+}
 
-                // If the node's state has not been visited, or has a lower g-value, we continue.
-                if(visitedStates.find(currentState) == visitedStates.end() || visitedStates[currentState].g > newNode.g)
-                {
-                    statesExplored++;
-                    // Insert the current pivot index in the path so we can re-trace it later.
-                    newNode.path.push(pivotIndex);
-                    // Map the current state to the new node/replace the old node with the new one that has a better g-value.
-                    visitedStates[currentState] = newNode;
-                    // Push it into the heap.
-                    minHeap.push(newNode);
-                }
-            }
-        }
+// Output: True if the child's state had not been visited, or only with a higher g-value, in which case it is stored and pushed into the heap.
+bool SlidingPuzzleSolver::storeChild(const Node& child, std::unordered_map<std::string, Node>& visitedStates, std::priority_queue<Node, std::vector<Node>, CompareNodes>& minHeap)
+{
+    const auto visited = visitedStates.find(child.state);
+    if(visited != visitedStates.end() && visited->second.g <= child.g)
+        return false;
+    statesExplored++;
+    // Map the current state to the new node/replace the old node with the new one that has a better g-value.
+    if(visited == visitedStates.end())
+        visitedStates.emplace(child.state, child);
+    else
+        visited->second = child;
+    minHeap.push(child);
+    return true;
+}
+
+// Input: A board state and the sub-goal being searched for.
+// Output: h(n), the estimated cost from the state to the sub-goal.
+int SlidingPuzzleSolver::getHeuristic(const std::string& state, const SubGoal& goalState) const
+{
+    int heuristic = getTargetDistance(state, goalState);
+
+    // The second heuristic: the total linear conflict of the remaining board.
+    for(int i = 0; i < n; i++)
+    {
+        heuristic += getLinearConflict(state, i, true);
+        heuristic += getLinearConflict(state, i, false);
     }
+    return heuristic;
 }
 
-// Checks if a state is solvable for a given n x n where n is even.
-// If even number of columns:
-// 1. If the blank row is 1 from the bottom (1-indexed), the number of inversions must be even for it to be solvable.
-// 2. If the blank row is 2 from the bottom (1-indexed), the number of inversions must be odd for it to be solvable.
-bool SlidingPuzzleSolver::isSolvableEven(const std::string& state) const
+// The first heuristic: the Manhattan distance of the target tile from its target placement.
+// Alternatively, Chebyshev distance can be used: https://www.researchgate.net/publication/301536229_A_Comparative_Study_of_Three_Heuristic_Functions_Used_to_Solve_the_8-Puzzle
+int SlidingPuzzleSolver::getTargetDistance(const std::string& state, const SubGoal& goalState) const
 {
-    int inversions = 0;
-    int blankRowFromBottom;
-    for(int i = 0; i < state.size(); i++)
+    int targetDistance = 0;
+    for(int i = 0; i < goalState.targetTileNumbers.size(); i++)
     {
         if(state[i] != 'a' + n * n - 1)
-        {
-            for(int j = i + 1; j < state.size(); j++)
-            {
-                if(state[j] != 'a' + n * n - 1 && state[i] > state[j])
-                    inversions++;
-            }
-        }
-        else
-        {
-            blankRowFromBottom = currentBoardN - (i / currentBoardN);
-        }
+            targetDistance += model.getChebyshevDistance(state.find('a' + goalState.targetTileNumbers[i]), goalState.targetTileNumbers[i]) * 2;
+            // targetDistance += model.getManhattanDistance(state.find('a' + goalState.targetTileNumbers[i]), goalState.targetTileNumbers[i]);
     }
-    if(blankRowFromBottom % 2 == 1)
-        return inversions % 2 == 0;
-    return inversions % 2 == 1;
+    return targetDistance;
 }
 
-// Checks if a state is solvable for a given n x n where n is odd.
-// If odd number of columns: the parity MUST be even.
-bool SlidingPuzzleSolver::isSolvableOdd(const std::string& state) const {
+// Input: A board state, a row or column number, and whether it is a row.
+// Output: The linear conflict penalty of that line.
+int SlidingPuzzleSolver::getLinearConflict(const std::string& state, const int& line, const bool& isRow) const
+{
+    // Pass in the current row as a flattened string.
+    if(isRow)
+        return model.getHorizontalLinearConflict(state.substr(line * n, n), line);
+    // Pass in the current column as a flattened string.
+    std::string flattenedVertical;
+    for(int j = 0; j < n; j++)
+    {
+        flattenedVertical += state[j * n + line];
+    }
+    return model.getVerticalLinearConflict(flattenedVertical, line);
+}
+
+// Keys the learned values by state and sub-goal, so values learned for an earlier sub-goal's heuristic are never read back and the table never needs clearing.
+size_t SlidingPuzzleSolver::getLearnedHeuristicKey(const std::string& state) const
+{
+    return std::hash<std::string>()(state) ^ (static_cast<size_t>(realTimeSubGoalIndex) + 1) * 0x9E3779B97F4A7C15ULL;
+}
+
+// Returns the h-value learned by realTimeStep for the state if there is one, otherwise getHeuristic.
+int SlidingPuzzleSolver::getLearnedHeuristic(const std::string& state, const SubGoal& goalState) const
+{
+    if(!learnedHeuristics.empty())
+    {
+        const size_t stateHash = getLearnedHeuristicKey(state);
+        const auto& [learnedHash, learnedHeuristic] = learnedHeuristics[stateHash % learnedHeuristics.size()];
+        if(learnedHeuristic >= 0 && learnedHash == stateHash)
+            return learnedHeuristic;
+    }
+    return getHeuristic(state, goalState);
+}
+
+// Checks if every target tile of the sub-goal is in place. The remainder is always solvable here, as solvability was proven before searching.
+bool SlidingPuzzleSolver::isSubGoalReached(const std::string& state, const SubGoal& goalState) const
+{
+    for(const auto& targetTileNumber : goalState.targetTileNumbers)
+    {
+        if(state[targetTileNumber] - 'a' != targetTileNumber)
+            return false;
+    }
+    return true;
+}
+
+/*
+ * Treating the empty space as the tile n * n - 1, every move is a single transposition and moves the empty space by one square.
+ * So the parity of the permutation and the parity of the empty space's Manhattan distance from its goal both flip on every move.
+ * A board is solvable exactly when the two parities are equal, and this holds for any sub-board left once the locked tiles are in place,
+ * as locked tiles are fixed points of the permutation. This is the blank-row rule in a form that does not depend on whether n is odd or even.
+ * Input: A board state.
+ * Output: The parity of the number of inversions, counting the empty space as the largest tile. O(n^4); only used once per solve.
+ */
+bool SlidingPuzzleSolver::getPermutationParity(const std::string& state)
+{
     int inversions = 0;
     for(int i = 0; i < state.size(); i++)
     {
-        if(state[i] != 'a' + n * n - 1)
+        for(int j = i + 1; j < state.size(); j++)
         {
-            for(int j = i + 1; j < state.size(); j++)
-            {
-                if(state[j] != 'a' + n * n - 1 && state[i] > state[j])
-                    inversions++;
-            }
+            if(state[i] > state[j])
+                inversions++;
         }
     }
-    return inversions % 2 == 0;
+    return inversions % 2 == 1;
+}
+
+// Checks if a full board state is solvable. Static, so a board can be checked without building a solver.
+bool SlidingPuzzleSolver::isSolvable(const std::string& state)
+{
+    const int n = static_cast<int>(std::lround(std::sqrt(state.size())));
+    const int pivotIndex = static_cast<int>(state.find(static_cast<char>('a' + n * n - 1)));
+    // The Manhattan distance of the empty space from its goal, the bottom-right corner.
+    const int pivotDistance = n - 1 - pivotIndex / n + n - 1 - pivotIndex % n;
+    return getPermutationParity(state) == (pivotDistance % 2 == 1);
 }
 
 // Add the solution steps to the model. These are used to draw the solution.
@@ -1,8 +1,11 @@
 #ifndef SLIDINGPUZZLESOLVER_H
 #define SLIDINGPUZZLESOLVER_H
 #include "CompareNodes.h"
+#include "SubGoalCache.h"
 #include <unordered_set>
 #include <algorithm>
+#include <limits>
+#include <chrono>
 #include "SubGoal.h"
 #include "Model.h"
 #include <queue>
@@ -10,21 +13,47 @@
 class SlidingPuzzleSolver
 {
 public:
+    static constexpr int solvedStep = -1;   // Returned by realTimeStep once the board is solved.
+    static constexpr int noMoveStep = -2;   // Returned by realTimeStep when no move can be made: the board is unsolvable or the lookahead found no legal move.
+
     explicit SlidingPuzzleSolver(Model& model);
     int getStatesExplored() const;
-    void solve();
+    void setDeadline(const std::chrono::steady_clock::time_point& newDeadline);
+    void setCache(SubGoalCache* newCache);
+    void setStateLimit(const size_t& limit);
+    bool hasReachedStateLimit() const;
+    bool solve();
+    int realTimeStep(const int& expansionBudget, const std::chrono::microseconds& timeBudget = std::chrono::microseconds::zero());
+    static bool isSolvable(const std::string& state);
 private:
-    int currentBoardN;                      // The dimensions of the unresolved portion of the current board.
+    friend struct SolverBenchmark;
+
     int statesExplored;                     // The total amount of states explored by A*.
     int n;                                  // The total dimension of the board.
 
     Model& model;
+    std::chrono::steady_clock::time_point deadline;   // The search gives up once this point in time is passed. Defaults to no deadline.
+    SubGoalCache* cache;                    // Optional cache of sub-goal solutions. Not owned by the solver.
+    size_t stateLimit;                      // The most states a single aStar call may store before giving up. Defaults to no limit.
+    bool isStateLimitReached;               // Set when aStar gave up because of stateLimit.
     std::unordered_set<int> lockedTiles;    // Tile indices stored in this set may not be moved by the algorithm.
+    std::unordered_set<int> realTimeLockedTiles;    // The locked tiles of realTimeStep, kept apart from solve()'s.
     std::vector<SubGoal> subGoals;          // Goal steps are generated and stored.
+    int realTimeSubGoalIndex;               // The sub-goal realTimeStep is working on, or -1 before the first step.
+    std::vector<std::pair<size_t, int>> learnedHeuristics;     // h-values raised by realTimeStep, indexed by state and sub-goal hash. Fixed size, so a colliding state overwrites the older entry.
 
-    bool isSolvableEven(const std::string& state) const;
-    bool isSolvableOdd(const std::string& state) const;
-    void aStar(const SubGoal& goalState);
+    bool aStar(const SubGoal& goalState);
+    static Node popBestNode(std::priority_queue<Node, std::vector<Node>, CompareNodes>& minHeap);
+    bool generateChild(const Node& parent, const int& neighbor, const SubGoal& goalState, Node& child) const;
+    bool storeChild(const Node& child, std::unordered_map<std::string, Node>& visitedStates, std::priority_queue<Node, std::vector<Node>, CompareNodes>& minHeap);
+    static bool getPermutationParity(const std::string& state);
+    int getHeuristic(const std::string& state, const SubGoal& goalState) const;
+    int getTargetDistance(const std::string& state, const SubGoal& goalState) const;
+    int getLinearConflict(const std::string& state, const int& line, const bool& isRow) const;
+    size_t getLearnedHeuristicKey(const std::string& state) const;
+    int getLearnedHeuristic(const std::string& state, const SubGoal& goalState) const;
+    bool isSubGoalReached(const std::string& state, const SubGoal& goalState) const;
+    bool applyCachedSteps(const std::vector<int>& pivots, const SubGoal& goalState);
     void addSolutionSteps(Node& node);
     void generateSubGoals();
 };
@@ -0,0 +1,224 @@
+#include "SolutionCache.h"
+#include <sys/mman.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <iostream>
+#include <unistd.h>
+#include <cstring>
+#include <fcntl.h>
+
+namespace
+{
+    // Every cache file starts with this tag. Records follow it: uint64 key, uint16 pivot count, then one byte per pivot index.
+    constexpr char fileTag[4] = {'S', 'P', 'C', '1'};
+    constexpr size_t recordHeaderSize = sizeof(uint64_t) + sizeof(uint16_t);
+
+    // FNV-1a, 64-bit.
+    void hashBytes(uint64_t& hash, const void* data, const size_t& size)
+    {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for(size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    }
+}
+
+SolutionCache::SolutionCache(const size_t& capacity, const std::string& filePath)
+    : capacity(std::max<size_t>(capacity, 1)), hits(0), misses(0), fileDescriptor(-1), mappedFile(nullptr), mappedSize(0)
+{
+    if(!filePath.empty())
+        openFile(filePath);
+}
+
+SolutionCache::~SolutionCache()
+{
+    if(mappedFile != nullptr && munmap(const_cast<uint8_t*>(mappedFile), mappedSize) < 0)
+        std::cerr << "Failed to unmap cache file: " << std::strerror(errno) << '\n';
+    if(fileDescriptor >= 0)
+        close(fileDescriptor);
+}
+
+/*
+ * Maps the existing file and indexes its records. A record cut short by a crash is truncated away so new records are appended after the last complete one.
+ * The file is locked exclusively while this runs, so the truncation never cuts off a record another process sharing the file is appending.
+ */
+void SolutionCache::openFile(const std::string& filePath)
+{
+    fileDescriptor = open(filePath.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if(fileDescriptor < 0)
+    {
+        std::cerr << "Failed to open cache file " << filePath << ": " << std::strerror(errno) << '\n';
+        return;
+    }
+    // Without the lock, another process could be appending while the file is truncated below, so the file is not used at all.
+    // Closing the file on a failure below also releases the lock.
+    struct stat fileStatus{};
+    if(flock(fileDescriptor, LOCK_EX) < 0 || fstat(fileDescriptor, &fileStatus) < 0)
+    {
+        closeFile("Failed to lock cache file " + filePath);
+        return;
+    }
+    const auto fileSize = static_cast<size_t>(fileStatus.st_size);
+
+    size_t validSize = 0;
+    if(fileSize >= sizeof(fileTag))
+    {
+        void* mapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        if(mapping == MAP_FAILED)
+        {
+            closeFile("Failed to map cache file " + filePath);
+            return;
+        }
+        if(std::memcmp(mapping, fileTag, sizeof(fileTag)) == 0)
+        {
+            mappedFile = static_cast<const uint8_t*>(mapping);
+            mappedSize = fileSize;
+            size_t offset = sizeof(fileTag);
+            while(offset + recordHeaderSize <= fileSize)
+            {
+                uint64_t key;
+                uint16_t count;
+                std::memcpy(&key, mappedFile + offset, sizeof(key));
+                std::memcpy(&count, mappedFile + offset + sizeof(key), sizeof(count));
+                if(offset + recordHeaderSize + count > fileSize)
+                    break;
+                mappedEntries[key] = offset;
+                offset += recordHeaderSize + count;
+            }
+            validSize = offset;
+        }
+        else
+        {
+            if(munmap(mapping, fileSize) < 0)
+                std::cerr << "Failed to unmap cache file " << filePath << ": " << std::strerror(errno) << '\n';
+            std::cerr << "Ignoring cache file " << filePath << " as it is not a solution cache.\n";
+            close(fileDescriptor);
+            fileDescriptor = -1;
+            return;
+        }
+    }
+    if(ftruncate(fileDescriptor, static_cast<off_t>(validSize)) < 0 || (validSize == 0 && write(fileDescriptor, fileTag, sizeof(fileTag)) < 0))
+    {
+        closeFile("Failed to prepare cache file " + filePath);
+        return;
+    }
+    if(flock(fileDescriptor, LOCK_UN) < 0)
+        closeFile("Failed to unlock cache file " + filePath);
+}
+
+// Stops using the file after a failed system call, so this process never writes to it unlocked. Entries already mapped are still served.
+void SolutionCache::closeFile(const std::string& reason)
+{
+    std::cerr << reason << ": " << std::strerror(errno) << ". The cache is kept in memory only.\n";
+    close(fileDescriptor);
+    fileDescriptor = -1;
+}
+
+// The locked tiles are hashed in sorted order so the key does not depend on the iteration order of the set.
+uint64_t SolutionCache::getKey(const std::string& board, const std::unordered_set<int>& lockedTiles, const SubGoal& subGoal) const
+{
+    uint64_t hash = 14695981039346656037ULL;
+    hashBytes(hash, board.data(), board.size());
+    std::vector<int> sortedLockedTiles(lockedTiles.begin(), lockedTiles.end());
+    std::sort(sortedLockedTiles.begin(), sortedLockedTiles.end());
+    const int separator = -1;
+    hashBytes(hash, &separator, sizeof(separator));
+    hashBytes(hash, sortedLockedTiles.data(), sortedLockedTiles.size() * sizeof(int));
+    hashBytes(hash, &separator, sizeof(separator));
+    hashBytes(hash, subGoal.targetTileNumbers.data(), subGoal.targetTileNumbers.size() * sizeof(int));
+    hashBytes(hash, &subGoal.isEndingSequence, sizeof(subGoal.isEndingSequence));
+    return hash;
+}
+
+// Input: The key of the sub-goal.
+// Output: True and the cached pivot indices if the key is cached in memory or in the mapped file.
+bool SolutionCache::lookup(const uint64_t& key, std::vector<int>& pivots)
+{
+    std::lock_guard lock(mutex);
+    if(const auto entry = entries.find(key); entry != entries.end())
+    {
+        recentlyUsed.splice(recentlyUsed.begin(), recentlyUsed, entry->second);
+        pivots = entry->second->second;
+        return true;
+    }
+    if(const auto mappedEntry = mappedEntries.find(key); mappedEntry != mappedEntries.end())
+    {
+        const uint8_t* record = mappedFile + mappedEntry->second;
+        uint16_t count;
+        std::memcpy(&count, record + sizeof(uint64_t), sizeof(count));
+        pivots.assign(record + recordHeaderSize, record + recordHeaderSize + count);
+        insert(key, pivots);
+        return true;
+    }
+    return false;
+}
+
+// Counts a lookup once the caller knows whether its entry could be used. An entry that was found but rejected (a hash collision or a corrupted record)
+// counts as a miss, so the hit count is the number of sub-goals actually served from the cache.
+void SolutionCache::countLookup(const bool& isHit)
+{
+    std::lock_guard lock(mutex);
+    if(isHit)
+        hits++;
+    else
+        misses++;
+}
+
+// Caches the pivots in memory and appends them to the file if they are not already persisted.
+void SolutionCache::store(const uint64_t& key, const std::vector<int>& pivots)
+{
+    std::lock_guard lock(mutex);
+    insert(key, pivots);
+    if(fileDescriptor < 0 || pivots.size() > UINT16_MAX || mappedEntries.count(key) > 0 || !appendedKeys.insert(key).second)
+        return;
+    std::string record(recordHeaderSize, '\0');
+    const auto count = static_cast<uint16_t>(pivots.size());
+    std::memcpy(record.data(), &key, sizeof(key));
+    std::memcpy(record.data() + sizeof(key), &count, sizeof(count));
+    for(const auto& pivot : pivots)
+        record += static_cast<char>(pivot);
+    // A single append keeps records whole even when several processes share the same file. The shared lock keeps another process from
+    // truncating the file (see openFile) while the record is being written.
+    if(flock(fileDescriptor, LOCK_SH) < 0)
+    {
+        closeFile("Failed to lock cache file");
+        return;
+    }
+    if(write(fileDescriptor, record.data(), record.size()) < 0)
+        std::cerr << "Failed to append to cache file: " << std::strerror(errno) << '\n';
+    if(flock(fileDescriptor, LOCK_UN) < 0)
+        closeFile("Failed to unlock cache file");
+}
+
+// Inserts or refreshes an entry at the front of the recently-used list, evicting the least recently used entry when full. The mutex must be held.
+void SolutionCache::insert(const uint64_t& key, const std::vector<int>& pivots)
+{
+    if(const auto entry = entries.find(key); entry != entries.end())
+    {
+        entry->second->second = pivots;
+        recentlyUsed.splice(recentlyUsed.begin(), recentlyUsed, entry->second);
+        return;
+    }
+    recentlyUsed.emplace_front(key, pivots);
+    entries[key] = recentlyUsed.begin();
+    if(entries.size() > capacity)
+    {
+        entries.erase(recentlyUsed.back().first);
+        recentlyUsed.pop_back();
+    }
+}
+
+uint64_t SolutionCache::getHits() const
+{
+    std::lock_guard lock(mutex);
+    return hits;
+}
+
+uint64_t SolutionCache::getMisses() const
+{
+    std::lock_guard lock(mutex);
+    return misses;
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef SOLUTIONCACHE_H
+#define SOLUTIONCACHE_H
+#include <unordered_map>
+#include <mutex>
+#include <list>
+#include "SubGoalCache.h"
+
+/*
+ * Caches the moves that solve a sub-goal, keyed by a hash of (board state, locked tiles, sub-goal).
+ * Entries are kept in memory with least-recently-used eviction. If a file path is given, every new entry is also appended to that file,
+ * and the file is memory-mapped at startup so entries from previous runs can be served without searching.
+ * A cached entry holds the pivot indices visited while reaching the sub-goal, starting with the pivot before the first move and ending with the pivot after the last.
+ * Safe to share between threads, and the file can be shared between processes. If the file cannot be locked, the cache stops using it rather than
+ * risk interleaving its appends with another process's.
+ */
+class SolutionCache : public SubGoalCache
+{
+public:
+    explicit SolutionCache(const size_t& capacity, const std::string& filePath = "");
+    ~SolutionCache() override;
+    SolutionCache(const SolutionCache&) = delete;
+    SolutionCache& operator=(const SolutionCache&) = delete;
+
+    uint64_t getKey(const std::string& board, const std::unordered_set<int>& lockedTiles, const SubGoal& subGoal) const override;
+    bool lookup(const uint64_t& key, std::vector<int>& pivots) override;
+    void store(const uint64_t& key, const std::vector<int>& pivots) override;
+    void countLookup(const bool& isHit) override;
+    uint64_t getHits() const;
+    uint64_t getMisses() const;
+
+private:
+    using Entry = std::pair<uint64_t, std::vector<int>>;
+
+    size_t capacity;                                                        // The maximum number of entries held in memory.
+    std::list<Entry> recentlyUsed;                                          // Most recently used entries are at the front.
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> entries;       // Maps a key to its position in recentlyUsed.
+    uint64_t hits;
+    uint64_t misses;
+    mutable std::mutex mutex;
+
+    int fileDescriptor;                                                     // The append-only cache file, or -1 if the cache is memory only.
+    const uint8_t* mappedFile;                                              // The contents of the file at startup.
+    size_t mappedSize;
+    std::unordered_map<uint64_t, size_t> mappedEntries;                     // Maps a key to the offset of its record in mappedFile.
+    std::unordered_set<uint64_t> appendedKeys;                              // Keys written to the file during this run.
+
+    void openFile(const std::string& filePath);
+    void closeFile(const std::string& reason);
+    void insert(const uint64_t& key, const std::vector<int>& pivots);
+};
+
+#endif //SOLUTIONCACHE_H
\ No newline at end of file
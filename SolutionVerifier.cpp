@@ -0,0 +1,162 @@
+#include "SolutionVerifier.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <cmath>
+#include <array>
+
+namespace
+{
+    constexpr int maxN = 8;
+    constexpr size_t solutionHeaderSize = sizeof(uint64_t) + sizeof(uint32_t);
+
+    // legalMoves[n][pivot] has bit m set if the empty space can make move m from pivot on an n x n board.
+    using LegalMoveTable = std::array<std::array<uint8_t, maxN * maxN>, maxN + 1>;
+
+    LegalMoveTable buildLegalMoves()
+    {
+        LegalMoveTable legalMoves{};
+        for(int n = 2; n <= maxN; n++)
+        {
+            for(int pivot = 0; pivot < n * n; pivot++)
+            {
+                uint8_t mask = 0;
+                if(pivot >= n)
+                    mask |= 1 << Up;
+                if(pivot < n * n - n)
+                    mask |= 1 << Down;
+                if(pivot % n != 0)
+                    mask |= 1 << Left;
+                if(pivot % n != n - 1)
+                    mask |= 1 << Right;
+                legalMoves[n][pivot] = mask;
+            }
+        }
+        return legalMoves;
+    }
+
+    const LegalMoveTable legalMoves = buildLegalMoves();
+
+    // Converts tile numbers to Model's format. Returns false if they are not a permutation of 0 to n * n - 1.
+    bool loadBoard(const uint8_t* tiles, const int& n, char* board)
+    {
+        bool seen[maxN * maxN] = {};
+        for(int i = 0; i < n * n; i++)
+        {
+            if(tiles[i] >= n * n || seen[tiles[i]])
+                return false;
+            seen[tiles[i]] = true;
+            board[i] = static_cast<char>('a' + tiles[i]);
+        }
+        return true;
+    }
+}
+
+// Appends a record in the batch format described in SolutionVerifier.h. The board is given in Model's format.
+void SolutionVerifier::appendRecord(std::string& buffer, const std::string& board, const EncodedSolution& solution)
+{
+    const int n = static_cast<int>(std::lround(std::sqrt(board.size())));
+    buffer += static_cast<char>(n);
+    for(const char& c : board)
+        buffer += static_cast<char>(c - 'a');
+    solution.serialize(buffer);
+}
+
+// Verifies a single solution against a board in Model's format. failedMove is set to the first illegal move, if any.
+VerificationResult SolutionVerifier::verify(const std::string& board, const EncodedSolution& solution, uint32_t& failedMove)
+{
+    const int n = static_cast<int>(std::lround(std::sqrt(board.size())));
+    if(n < 2 || n > maxN || n * n != board.size() || solution.packedMoves.size() < (solution.moveCount + 3) / 4)
+        return VerificationResult::Malformed;
+    char boardCopy[maxN * maxN];
+    std::memcpy(boardCopy, board.data(), board.size());
+    return verifyMoves(boardCopy, n, solution.boardHash, solution.packedMoves.data(), solution.moveCount, failedMove);
+}
+
+/*
+ * Input: A buffer of records, the number of threads to verify with, and a counter for the number of records found.
+ * Output: Every record that is not a valid solution, in record order. A truncated final record is reported as Malformed.
+ */
+std::vector<VerificationFailure> SolutionVerifier::verifyRecords(const uint8_t* data, const size_t& size, const int& threadCount, size_t& recordCount)
+{
+    std::vector<VerificationFailure> failures;
+    // A cheap first pass finds where each record starts so the records can be split between threads.
+    std::vector<size_t> offsets;
+    size_t offset = 0;
+    while(offset < size)
+    {
+        const int n = data[offset];
+        if(n < 2 || n > maxN || offset + 1 + n * n + solutionHeaderSize > size)
+            break;
+        const auto moveCount = static_cast<uint32_t>(EncodedSolution::readLittleEndian(data + offset + 1 + n * n + sizeof(uint64_t), sizeof(uint32_t)));
+        const size_t recordSize = 1 + n * n + solutionHeaderSize + (static_cast<size_t>(moveCount) + 3) / 4;
+        if(offset + recordSize > size)
+            break;
+        offsets.push_back(offset);
+        offset += recordSize;
+    }
+    recordCount = offsets.size();
+
+    const size_t workerCount = std::clamp<size_t>(threadCount, 1, std::max<size_t>(offsets.size(), 1));
+    std::vector<std::vector<VerificationFailure>> workerFailures(workerCount);
+    std::vector<std::thread> workers;
+    for(size_t worker = 0; worker < workerCount; worker++)
+    {
+        workers.emplace_back([&, worker]()
+        {
+            const size_t first = offsets.size() * worker / workerCount;
+            const size_t last = offsets.size() * (worker + 1) / workerCount;
+            for(size_t i = first; i < last; i++)
+            {
+                const uint8_t* record = data + offsets[i];
+                const int n = record[0];
+                char board[maxN * maxN];
+                const uint64_t boardHash = EncodedSolution::readLittleEndian(record + 1 + n * n, sizeof(uint64_t));
+                const auto moveCount = static_cast<uint32_t>(EncodedSolution::readLittleEndian(record + 1 + n * n + sizeof(uint64_t), sizeof(uint32_t)));
+                uint32_t failedMove = 0;
+                VerificationResult result = VerificationResult::Malformed;
+                if(loadBoard(record + 1, n, board))
+                    result = verifyMoves(board, n, boardHash, record + 1 + n * n + solutionHeaderSize, moveCount, failedMove);
+                if(result != VerificationResult::Valid)
+                    workerFailures[worker].push_back({i, result, failedMove});
+            }
+        });
+    }
+    for(auto& worker : workers)
+        worker.join();
+    for(const auto& failuresOfWorker : workerFailures)
+        failures.insert(failures.end(), failuresOfWorker.begin(), failuresOfWorker.end());
+    if(offset < size)
+        failures.push_back({offsets.size(), VerificationResult::Malformed, 0});
+    return failures;
+}
+
+// The hot loop. Moves are decoded straight from the packed bytes and checked against a legality table, so no per-move allocation or branch on the board contents is needed.
+VerificationResult SolutionVerifier::verifyMoves(char* board, const int& n, const uint64_t& boardHash, const uint8_t* packedMoves, const uint32_t& moveCount, uint32_t& failedMove)
+{
+    if(EncodedSolution::hashBoard(board, n * n) != boardHash)
+        return VerificationResult::HashMismatch;
+    const char blank = static_cast<char>('a' + n * n - 1);
+    int pivot = static_cast<int>(std::find(board, board + n * n, blank) - board);
+    const int offsets[4] = {-n, n, -1, 1};
+    const auto& legalMovesOfN = legalMoves[n];
+    for(uint32_t i = 0; i < moveCount; i++)
+    {
+        const int move = packedMoves[i / 4] >> (i % 4 * 2) & 3;
+        if((legalMovesOfN[pivot] >> move & 1) == 0)
+        {
+            failedMove = i;
+            return VerificationResult::IllegalMove;
+        }
+        const int next = pivot + offsets[move];
+        board[pivot] = board[next];
+        pivot = next;
+    }
+    board[pivot] = blank;
+    for(int i = 0; i < n * n; i++)
+    {
+        if(board[i] != 'a' + i)
+            return VerificationResult::NotSolved;
+    }
+    return VerificationResult::Valid;
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef SOLUTIONVERIFIER_H
+#define SOLUTIONVERIFIER_H
+#include "MoveEncoding.h"
+#include <cstddef>
+
+enum class VerificationResult : uint8_t
+{
+    Valid = 0,
+    Malformed = 1,          // The record is truncated or its board is not a permutation of the tiles.
+    HashMismatch = 2,       // The solution was encoded for a different board.
+    IllegalMove = 3,        // A move takes the empty space off the board.
+    NotSolved = 4           // Every move is legal but the final board is not the solution.
+};
+
+struct VerificationFailure
+{
+    size_t recordIndex{};
+    VerificationResult result{};
+    uint32_t moveIndex{};   // The first illegal move. Only meaningful for IllegalMove.
+};
+
+/*
+ * Replays encoded solutions against their starting boards.
+ * A batch of records is a flat buffer, each record being: uint8 n, n * n bytes holding the tile number (0 to n * n - 1) at each index,
+ * followed by a serialized EncodedSolution. The tile numbered n * n - 1 is the empty space.
+ * Records are verified in place, without copying them out of the buffer, so a memory-mapped file can be checked directly.
+ */
+class SolutionVerifier
+{
+public:
+    static void appendRecord(std::string& buffer, const std::string& board, const EncodedSolution& solution);
+    static VerificationResult verify(const std::string& board, const EncodedSolution& solution, uint32_t& failedMove);
+    static std::vector<VerificationFailure> verifyRecords(const uint8_t* data, const size_t& size, const int& threadCount, size_t& recordCount);
+private:
+    static VerificationResult verifyMoves(char* board, const int& n, const uint64_t& boardHash, const uint8_t* packedMoves, const uint32_t& moveCount, uint32_t& failedMove);
+};
+
+#endif //SOLUTIONVERIFIER_H
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "SolutionVerifier.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <iostream>
+#include <unistd.h>
+#include <fcntl.h>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+    const char* resultNames[] = {"valid", "malformed record", "board hash mismatch", "illegal move", "board not solved"};
+}
+
+// Usage: SlidingPuzzleVerifier recordFile [threadCount]
+// Verifies every record in the file (format described in SolutionVerifier.h) and exits with 1 if any of them is not a valid solution.
+int main(int argc, char* argv[])
+{
+    if(argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " recordFile [threadCount]\n";
+        return 2;
+    }
+    const int threadCount = argc > 2 ? std::stoi(argv[2]) : static_cast<int>(std::thread::hardware_concurrency());
+    const int fd = open(argv[1], O_RDONLY);
+    struct stat fileStatus{};
+    if(fd < 0 || fstat(fd, &fileStatus) < 0)
+    {
+        std::cerr << "Failed to open " << argv[1] << '\n';
+        return 2;
+    }
+    const auto size = static_cast<size_t>(fileStatus.st_size);
+    const uint8_t* data = nullptr;
+    if(size > 0)
+    {
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(mapping == MAP_FAILED)
+        {
+            std::cerr << "Failed to map " << argv[1] << '\n';
+            return 2;
+        }
+        data = static_cast<const uint8_t*>(mapping);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    size_t recordCount = 0;
+    const std::vector<VerificationFailure> failures = SolutionVerifier::verifyRecords(data, size, threadCount, recordCount);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for(const auto& failure : failures)
+    {
+        std::cout << "Record " << failure.recordIndex << ": " << resultNames[static_cast<int>(failure.result)];
+        if(failure.result == VerificationResult::IllegalMove)
+            std::cout << " at move " << failure.moveIndex;
+        std::cout << '\n';
+    }
+    std::cout << "Verified " << recordCount << " records (" << size << " bytes) in " << seconds * 1000 << " ms, "
+              << failures.size() << " failed.\n";
+
+    if(data != nullptr)
+        munmap(const_cast<uint8_t*>(data), size);
+    close(fd);
+    return failures.empty() ? 0 : 1;
+}
\ No newline at end of file
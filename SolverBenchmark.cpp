@@ -0,0 +1,241 @@
+#include "SlidingPuzzleSolver.h"
+#include <functional>
+#include <iomanip>
+#include <cstdlib>
+#include <atomic>
+#include <new>
+
+/*
+ * Micro-benchmarks for the kernels inside the solver's search loop. Every kernel runs on the same fixed 4x4 board so results are comparable between builds.
+ * Reports the mean time per operation and the number of heap allocations per operation.
+ * Usage: SlidingPuzzleBenchmark [iterations]
+ */
+
+namespace
+{
+    std::atomic<uint64_t> allocationCount{0};
+
+    // Consumes a result so the compiler cannot remove the work that produced it.
+    volatile int sink;
+
+    // A fixed 4x4 board, scrambled from the solution so it is solvable.
+    const std::string fixedBoard = "ebcdafghnijkmolp";
+
+    // If a reset is given, it runs untimed before every resetInterval iterations, for kernels whose state has to be rebuilt as they run.
+    void runBenchmark(const std::string& name, const int& iterations, const std::function<void()>& kernel, const std::function<void()>& reset = nullptr,
+                      const int& resetInterval = 0)
+    {
+        const int chunkSize = reset != nullptr && resetInterval > 0 ? resetInterval : iterations;
+        // Warm up caches and the allocator before timing.
+        for(int i = 0; i < iterations / 10 + 1; i++)
+        {
+            if(i % chunkSize == 0 && reset != nullptr)
+                reset();
+            kernel();
+        }
+        uint64_t allocations = 0;
+        std::chrono::steady_clock::duration elapsed{};
+        for(int first = 0; first < iterations; first += chunkSize)
+        {
+            if(reset != nullptr)
+                reset();
+            const uint64_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+            const auto start = std::chrono::steady_clock::now();
+            for(int i = first; i < std::min(first + chunkSize, iterations); i++)
+                kernel();
+            elapsed += std::chrono::steady_clock::now() - start;
+            allocations += allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+        }
+        const double nanoseconds = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        std::cout << std::left << std::setw(44) << name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12) << nanoseconds / iterations << " ns/op"
+                  << std::setw(10) << static_cast<double>(allocations) / iterations << " allocs/op\n";
+    }
+}
+
+// Counts every heap allocation made by the kernels.
+void* operator new(const std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if(void* memory = std::malloc(size == 0 ? 1 : size))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+// Runs every benchmark. SlidingPuzzleSolver declares it a friend so it can reach the private search kernels.
+struct SolverBenchmark
+{
+    static void run(const int& iterations);
+};
+
+void SolverBenchmark::run(const int& iterations)
+{
+    Model model(fixedBoard);
+    SlidingPuzzleSolver solver(model);
+    const int n = model.getN();
+    const int pivotIndex = model.getPivotIndex();
+    const SubGoal& goalState = solver.subGoals.front();
+
+    // A parent node with a path of typical sub-goal length, used by the kernels that copy nodes.
+    Node parentNode(fixedBoard, pivotIndex, 0, solver.getHeuristic(fixedBoard, goalState));
+    for(int i = 0; i < 30; i++)
+        parentNode.path.push(i % (n * n));
+    const std::vector<int> parentNeighbors = model.getValidNeighbors(pivotIndex);
+
+    // A pool of distinct neighboring states for the open list and visited map kernels.
+    std::vector<std::string> states;
+    std::vector<int> statePivots;
+    // The walk uses a fixed seed and never undoes its previous move, so the pool is the same on every run and mostly free of repeats.
+    std::mt19937 mersenneTwisterEngine(2024);
+    std::string walkState = fixedBoard;
+    int walkPivot = pivotIndex;
+    int previousPivot = -1;
+    for(int i = 0; i < 1024; i++)
+    {
+        std::vector<int> neighbors = model.getValidNeighbors(walkPivot);
+        neighbors.erase(std::remove(neighbors.begin(), neighbors.end(), previousPivot), neighbors.end());
+        std::uniform_int_distribution distribution(0, static_cast<int>(neighbors.size()) - 1);
+        const int next = neighbors[distribution(mersenneTwisterEngine)];
+        std::swap(walkState[walkPivot], walkState[next]);
+        previousPivot = walkPivot;
+        walkPivot = next;
+        states.push_back(walkState);
+        statePivots.push_back(walkPivot);
+    }
+    // Children of the parent node, one per pooled state, for the kernels that store nodes.
+    std::vector<Node> children;
+    for(size_t i = 0; i < states.size(); i++)
+        children.emplace_back(states[i], statePivots[i], parentNode.path, static_cast<int>(i % 40), static_cast<int>(i % 17));
+
+    std::cout << "Board: " << fixedBoard << ", iterations: " << iterations << "\n\n";
+
+    int row = 0;
+    runBenchmark("getHorizontalLinearConflict", iterations, [&]()
+    {
+        sink = model.getHorizontalLinearConflict(fixedBoard.substr(row * n, n), row);
+        row = (row + 1) % n;
+    });
+
+    int column = 0;
+    runBenchmark("getVerticalLinearConflict", iterations, [&]()
+    {
+        std::string flattenedVertical;
+        for(int j = 0; j < n; j++)
+            flattenedVertical += fixedBoard[j * n + column];
+        sink = model.getVerticalLinearConflict(flattenedVertical, column);
+        column = (column + 1) % n;
+    });
+
+    int tile = 0;
+    runBenchmark("getManhattanDistance", iterations, [&]()
+    {
+        sink = model.getManhattanDistance(tile, n * n - 1 - tile);
+        tile = (tile + 1) % (n * n);
+    });
+
+    runBenchmark("getChebyshevDistance", iterations, [&]()
+    {
+        sink = model.getChebyshevDistance(tile, n * n - 1 - tile);
+        tile = (tile + 1) % (n * n);
+    });
+
+    runBenchmark("getValidNeighbors", iterations, [&]()
+    {
+        sink = static_cast<int>(model.getValidNeighbors(tile).size());
+        tile = (tile + 1) % (n * n);
+    });
+
+    const MovePruningAutomaton& movePruning = model.getMovePruning();
+    int pruningState = MovePruningAutomaton::startState;
+    int move = 0;
+    runBenchmark("move pruning transition", iterations, [&]()
+    {
+        const int next = movePruning.transition(pruningState, static_cast<Move>(move));
+        pruningState = next == MovePruningAutomaton::prunedState ? MovePruningAutomaton::startState : next;
+        move = (move + 3) % 4;
+        sink = pruningState;
+    });
+
+    size_t stateIndex = 0;
+    runBenchmark("getHeuristic", iterations, [&]()
+    {
+        sink = solver.getHeuristic(states[stateIndex], goalState);
+        stateIndex = (stateIndex + 1) % states.size();
+    });
+
+    size_t neighborIndex = 0;
+    runBenchmark("aStar child generation", iterations, [&]()
+    {
+        Node child;
+        sink = solver.generateChild(parentNode, parentNeighbors[neighborIndex], goalState, child);
+        neighborIndex = (neighborIndex + 1) % parentNeighbors.size();
+    });
+
+    runBenchmark("aStar state hashing", iterations, [&]()
+    {
+        sink = static_cast<int>(std::hash<std::string>()(states[stateIndex]));
+        stateIndex = (stateIndex + 1) % states.size();
+    });
+
+    // The open list is kept at a steady size so push and pop are measured together.
+    std::priority_queue<Node, std::vector<Node>, CompareNodes> minHeap;
+    for(const auto& child : children)
+        minHeap.push(child);
+    runBenchmark("open list push + pop", iterations, [&]()
+    {
+        Node node = SlidingPuzzleSolver::popBestNode(minHeap);
+        node.g++;
+        minHeap.push(node);
+    });
+
+    // Unvisited children are stored and pushed. Both containers are emptied, untimed, once the pool has been stored.
+    std::unordered_map<std::string, Node> visitedStates;
+    runBenchmark("aStar store child (new)", iterations, [&]()
+    {
+        sink = solver.storeChild(children[stateIndex], visitedStates, minHeap);
+        stateIndex++;
+    }, [&]()
+    {
+        minHeap = {};
+        visitedStates.clear();
+        stateIndex = 0;
+    }, static_cast<int>(children.size()));
+    stateIndex = 0;
+
+    // Every child has already been visited with the same g-value, so each one is only looked up and rejected.
+    for(const auto& child : children)
+        solver.storeChild(child, visitedStates, minHeap);
+    runBenchmark("aStar store child (visited)", iterations, [&]()
+    {
+        sink = solver.storeChild(children[stateIndex], visitedStates, minHeap);
+        stateIndex = (stateIndex + 1) % states.size();
+    });
+
+    runBenchmark("getPermutationParity", iterations, [&]()
+    {
+        sink = SlidingPuzzleSolver::getPermutationParity(states[stateIndex]);
+        stateIndex = (stateIndex + 1) % states.size();
+    });
+
+    runBenchmark("isSolvable", iterations, [&]()
+    {
+        sink = SlidingPuzzleSolver::isSolvable(states[stateIndex]);
+        stateIndex = (stateIndex + 1) % states.size();
+    });
+}
+
+int main(int argc, char* argv[])
+{
+    SolverBenchmark::run(argc > 1 ? std::stoi(argv[1]) : 1000000);
+    return 0;
+}
\ No newline at end of file
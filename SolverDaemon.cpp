@@ -0,0 +1,337 @@
+#include "SolverDaemon.h"
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <cstring>
+
+namespace
+{
+    // The board sizes the daemon accepts.
+    constexpr int minN = 3;
+    constexpr int maxN = 5;
+    constexpr size_t requestHeaderSize = 2 * sizeof(uint32_t) + sizeof(uint8_t);
+}
+
+ClientConnection::~ClientConnection()
+{
+    close(fd);
+}
+
+SolverDaemon::SolverDaemon(std::string socketPath, const int& workerCount, const size_t& maxBatchSize, SolutionCache* cache,
+                           const std::chrono::milliseconds& maxDeadline, const size_t& stateLimit, const std::string& recordFilePath)
+    : socketPath(std::move(socketPath)), workerCount(std::max(workerCount, 1)), maxBatchSize(std::max<size_t>(maxBatchSize, 1)), listenFd(-1), cache(cache),
+      maxDeadline(maxDeadline), stateLimit(stateLimit), running(false), recordFd(-1), activeReaders(0)
+{
+    if(!recordFilePath.empty())
+    {
+        recordFd = open(recordFilePath.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if(recordFd < 0)
+            std::cerr << "Failed to open record file " << recordFilePath << ": " << std::strerror(errno) << '\n';
+    }
+    // Every request reuses these tables, so no request pays for building them.
+    for(int n = minN; n <= maxN; n++)
+        tables.emplace(n, std::make_shared<const ModelTables>(n));
+}
+
+SolverDaemon::~SolverDaemon()
+{
+    stop();
+    if(recordFd >= 0)
+        close(recordFd);
+}
+
+// Binds the socket, starts the workers, and serves connections until stop() is called.
+void SolverDaemon::run()
+{
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(listenFd < 0)
+    {
+        std::cerr << "Failed to create socket: " << std::strerror(errno) << '\n';
+        return;
+    }
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if(socketPath.size() >= sizeof(address.sun_path))
+    {
+        std::cerr << "Socket path is too long: " << socketPath << '\n';
+        close(listenFd);
+        return;
+    }
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+    // Remove a stale socket left behind by a previous run.
+    unlink(socketPath.c_str());
+    if(bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(listenFd, SOMAXCONN) < 0)
+    {
+        std::cerr << "Failed to listen on " << socketPath << ": " << std::strerror(errno) << '\n';
+        close(listenFd);
+        return;
+    }
+
+    running = true;
+    for(int i = 0; i < workerCount; i++)
+        workerThreads.emplace_back(&SolverDaemon::workerLoop, this);
+    std::cout << "Listening on " << socketPath << " with " << workerCount << " workers.\n";
+
+    acceptConnections();
+
+    // Wake up every reader blocked on a connection and wait for them to finish, then wake up every idle worker.
+    {
+        std::unique_lock lock(connectionsMutex);
+        for(const auto& weakClient : connections)
+            if(const auto client = weakClient.lock())
+                shutdown(client->fd, SHUT_RDWR);
+        readersCondition.wait(lock, [this]() {return activeReaders == 0;});
+        connections.clear();
+    }
+    queueCondition.notify_all();
+    for(auto& thread : workerThreads)
+        thread.join();
+    workerThreads.clear();
+    close(listenFd);
+    unlink(socketPath.c_str());
+}
+
+// Only stores to an atomic, so this is safe to call from a signal handler.
+void SolverDaemon::stop()
+{
+    running = false;
+}
+
+void SolverDaemon::acceptConnections()
+{
+    pollfd listenPoll{listenFd, POLLIN, 0};
+    while(running)
+    {
+        // Poll with a timeout so a call to stop() is noticed without a new connection arriving.
+        if(poll(&listenPoll, 1, 200) <= 0)
+            continue;
+        const int clientFd = accept(listenFd, nullptr, nullptr);
+        if(clientFd < 0)
+            continue;
+        auto client = std::make_shared<ClientConnection>(clientFd);
+        std::lock_guard lock(connectionsMutex);
+        // Forget connections that have been closed, so the list only grows with the number of open connections.
+        connections.erase(std::remove_if(connections.begin(), connections.end(), [](const std::weak_ptr<ClientConnection>& weakClient)
+        {
+            return weakClient.expired();
+        }), connections.end());
+        connections.push_back(client);
+        // The reader is detached so its thread is released as soon as the client disconnects; activeReaders lets run() wait for it.
+        activeReaders++;
+        std::thread(&SolverDaemon::readRequests, this, client).detach();
+    }
+}
+
+// Reads requests from a single client and places them on the shared queue. Validation is done here so the workers only ever see well-formed boards.
+void SolverDaemon::readRequests(const std::shared_ptr<ClientConnection>& client)
+{
+    readClientRequests(client);
+    // Notify while holding the lock, so run() cannot return and destroy the daemon before this thread is done with it.
+    std::lock_guard lock(connectionsMutex);
+    activeReaders--;
+    readersCondition.notify_all();
+}
+
+void SolverDaemon::readClientRequests(const std::shared_ptr<ClientConnection>& client)
+{
+    while(running)
+    {
+        uint8_t header[requestHeaderSize];
+        if(!readFully(client->fd, header, sizeof(header)))
+            return;
+        const auto requestId = static_cast<uint32_t>(EncodedSolution::readLittleEndian(header, sizeof(uint32_t)));
+        const auto deadlineMilliseconds = static_cast<uint32_t>(EncodedSolution::readLittleEndian(header + sizeof(uint32_t), sizeof(uint32_t)));
+        const int n = header[2 * sizeof(uint32_t)];
+        // The protocol cannot be re-synchronized after a bad size, so the connection is dropped.
+        if(n < minN || n > maxN)
+            return;
+        std::string tiles(n * n, '\0');
+        if(!readFully(client->fd, tiles.data(), tiles.size()))
+            return;
+
+        SolveRequest request;
+        request.requestId = requestId;
+        request.received = std::chrono::steady_clock::now();
+        // No request may run longer than maxDeadline, so one hard board cannot hold a worker indefinitely.
+        const std::chrono::milliseconds requestDeadline(deadlineMilliseconds);
+        request.deadline = request.received + (deadlineMilliseconds == 0 || requestDeadline > maxDeadline ? maxDeadline : requestDeadline);
+        request.client = client;
+        // The board must be a permutation of the tile numbers.
+        std::vector<bool> seen(n * n, false);
+        request.isValid = true;
+        for(const char& tile : tiles)
+        {
+            const auto tileNumber = static_cast<uint8_t>(tile);
+            if(tileNumber >= n * n || seen[tileNumber])
+            {
+                request.isValid = false;
+                break;
+            }
+            seen[tileNumber] = true;
+            request.board += static_cast<char>('a' + tileNumber);
+        }
+
+        {
+            std::lock_guard lock(queueMutex);
+            requestQueue.push_back(std::move(request));
+        }
+        queueCondition.notify_one();
+    }
+}
+
+void SolverDaemon::workerLoop()
+{
+    std::vector<SolveRequest> batch;
+    while(true)
+    {
+        {
+            std::unique_lock lock(queueMutex);
+            queueCondition.wait(lock, [this]() {return !running || !requestQueue.empty();});
+            if(!running && requestQueue.empty())
+                return;
+            // Take several requests in one go so the queue lock is amortized across the batch, but no more than a fair share of the queue,
+            // so requests are not held by one worker while another is idle.
+            const size_t batchSize = std::min(maxBatchSize, (requestQueue.size() + workerCount - 1) / workerCount);
+            while(!requestQueue.empty() && batch.size() < batchSize)
+            {
+                batch.push_back(std::move(requestQueue.front()));
+                requestQueue.pop_front();
+            }
+        }
+        processBatch(batch);
+        batch.clear();
+    }
+}
+
+/*
+ * Each response is written as soon as its request is done. Requests that need no search (invalid, already past their deadline, or unsolvable)
+ * are answered before any search starts, so they are never held back by a slow search in the same batch.
+ */
+void SolverDaemon::processBatch(std::vector<SolveRequest>& batch)
+{
+    std::string buffer;
+    std::vector<SolveRequest*> searches;
+    for(auto& request : batch)
+    {
+        const auto started = std::chrono::steady_clock::now();
+        const auto queueMicroseconds = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(started - request.received).count());
+        const int n = static_cast<int>(std::lround(std::sqrt(request.board.size())));
+        buffer.clear();
+        if(!request.isValid)
+            appendResponse(buffer, request.requestId, SolveStatus::InvalidRequest, 0, queueMicroseconds, 0, EncodedSolution());
+        else if(started > request.deadline)
+            appendResponse(buffer, request.requestId, SolveStatus::DeadlineExceeded, 0, queueMicroseconds, 0, EncodedSolution::encode(request.board, {}, n));
+        else if(!SlidingPuzzleSolver::isSolvable(request.board))
+        {
+            const auto solveMicroseconds = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started).count());
+            appendResponse(buffer, request.requestId, SolveStatus::Unsolved, 0, queueMicroseconds, solveMicroseconds, EncodedSolution::encode(request.board, {}, n));
+        }
+        else
+        {
+            searches.push_back(&request);
+            continue;
+        }
+        sendResponse(request.client, buffer);
+    }
+
+    for(const auto* request : searches)
+    {
+        const auto started = std::chrono::steady_clock::now();
+        const auto queueMicroseconds = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(started - request->received).count());
+        const int n = static_cast<int>(std::lround(std::sqrt(request->board.size())));
+        Model model(tables.at(n), request->board);
+
+        SlidingPuzzleSolver solver(model);
+        solver.setDeadline(request->deadline);
+        solver.setCache(cache);
+        solver.setStateLimit(stateLimit);
+        const bool isSolved = solver.solve();
+        const auto solveMicroseconds = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started).count());
+        SolveStatus status = SolveStatus::Solved;
+        EncodedSolution solution = EncodedSolution::encode(request->board, isSolved ? model.getSolutionSteps() : std::vector<int>(), n);
+        uint32_t failedMove;
+        if(!isSolved && solver.hasReachedStateLimit())
+            status = SolveStatus::StateLimitExceeded;
+        else if(!isSolved)
+            status = std::chrono::steady_clock::now() > request->deadline ? SolveStatus::DeadlineExceeded : SolveStatus::Unsolved;
+        else if(SolutionVerifier::verify(request->board, solution, failedMove) != VerificationResult::Valid)
+        {
+            std::cerr << "Solution for request " << request->requestId << " failed verification at move " << failedMove << '\n';
+            status = SolveStatus::VerificationFailed;
+            solution = EncodedSolution::encode(request->board, {}, n);
+        }
+        if(status == SolveStatus::Solved)
+            recordSolution(request->board, solution);
+        buffer.clear();
+        appendResponse(buffer, request->requestId, status, static_cast<uint32_t>(solver.getStatesExplored()), queueMicroseconds, solveMicroseconds, solution);
+        sendResponse(request->client, buffer);
+    }
+}
+
+// Each record is written with a single append, so records from different workers never interleave. Recording stops after a failed write.
+void SolverDaemon::recordSolution(const std::string& board, const EncodedSolution& solution)
+{
+    std::lock_guard lock(recordMutex);
+    if(recordFd < 0)
+        return;
+    std::string record;
+    SolutionVerifier::appendRecord(record, board, solution);
+    if(write(recordFd, record.data(), record.size()) != static_cast<ssize_t>(record.size()))
+    {
+        std::cerr << "Failed to append to record file: " << std::strerror(errno) << ". Solutions are no longer recorded.\n";
+        close(recordFd);
+        recordFd = -1;
+    }
+}
+
+// Several workers may answer the same client, so writes to a connection are serialized.
+void SolverDaemon::sendResponse(const std::shared_ptr<ClientConnection>& client, const std::string& buffer)
+{
+    std::lock_guard lock(client->writeMutex);
+    writeFully(client->fd, buffer.data(), buffer.size());
+}
+
+void SolverDaemon::appendResponse(std::string& buffer, const uint32_t& requestId, const SolveStatus& status, const uint32_t& statesExplored,
+                                  const uint32_t& queueMicroseconds, const uint32_t& solveMicroseconds, const EncodedSolution& solution)
+{
+    EncodedSolution::appendLittleEndian(buffer, requestId, sizeof(requestId));
+    buffer += static_cast<char>(status);
+    EncodedSolution::appendLittleEndian(buffer, statesExplored, sizeof(statesExplored));
+    EncodedSolution::appendLittleEndian(buffer, queueMicroseconds, sizeof(queueMicroseconds));
+    EncodedSolution::appendLittleEndian(buffer, solveMicroseconds, sizeof(solveMicroseconds));
+    solution.serialize(buffer);
+}
+
+bool SolverDaemon::readFully(const int& fd, void* buffer, const size_t& size)
+{
+    auto* bytes = static_cast<char*>(buffer);
+    size_t received = 0;
+    while(received < size)
+    {
+        const ssize_t count = read(fd, bytes + received, size - received);
+        if(count < 0 && errno == EINTR)
+            continue;
+        if(count <= 0)
+            return false;
+        received += count;
+    }
+    return true;
+}
+
+bool SolverDaemon::writeFully(const int& fd, const char* buffer, size_t size)
+{
+    while(size > 0)
+    {
+        // MSG_NOSIGNAL avoids SIGPIPE killing the daemon when a client disconnects before its responses are written.
+        const ssize_t count = send(fd, buffer, size, MSG_NOSIGNAL);
+        if(count < 0 && errno == EINTR)
+            continue;
+        if(count <= 0)
+            return false;
+        buffer += count;
+        size -= count;
+    }
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#ifndef SOLVERDAEMON_H
+#define SOLVERDAEMON_H
+#include "SlidingPuzzleSolver.h"
+#include "SolutionVerifier.h"
+#include "SolutionCache.h"
+#include <condition_variable>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <deque>
+
+/*
+ * Binary protocol spoken over the Unix domain socket. All integers are little-endian, whatever the byte order of the host.
+ * Request:  uint32 requestId, uint32 deadlineMilliseconds (0 = the daemon's maximum), uint8 n, n * n bytes holding the tile number (0 to n * n - 1) at each index.
+ *           The tile numbered n * n - 1 is the empty space.
+ * Response: uint32 requestId, uint8 status, uint32 statesExplored, uint32 queueMicroseconds, uint32 solveMicroseconds,
+ *           followed by the solution serialized as an EncodedSolution (see MoveEncoding.h). Unsolved requests carry a solution with no moves.
+ * Every solution is replayed by SolutionVerifier before it is sent. If a record file is given, every solved request is also appended to it in the
+ * format described in SolutionVerifier.h, so SlidingPuzzleVerifier can check everything the daemon has sent.
+ * A client may pipeline any number of requests on one connection; responses carry the requestId as they may be returned out of order.
+ */
+enum class SolveStatus : uint8_t
+{
+    Solved = 0,
+    DeadlineExceeded = 1,
+    InvalidRequest = 2,
+    Unsolved = 3,
+    VerificationFailed = 4,
+    StateLimitExceeded = 5      // A sub-goal search stored more states than the daemon allows.
+};
+
+// A client connection. Shared between the reader thread and the workers so the socket stays open until every response has been written.
+struct ClientConnection
+{
+    explicit ClientConnection(const int& fd) : fd(fd) {}
+    ~ClientConnection();
+    int fd;
+    std::mutex writeMutex;
+};
+
+struct SolveRequest
+{
+    uint32_t requestId{};
+    std::chrono::steady_clock::time_point received;
+    std::chrono::steady_clock::time_point deadline;
+    std::string board;      // Board in Model's format: 'a' + tile number at each index.
+    bool isValid{};
+    std::shared_ptr<ClientConnection> client;
+};
+
+class SolverDaemon
+{
+public:
+    SolverDaemon(std::string socketPath, const int& workerCount, const size_t& maxBatchSize, SolutionCache* cache = nullptr,
+                 const std::chrono::milliseconds& maxDeadline = std::chrono::milliseconds(10000), const size_t& stateLimit = 250000, const std::string& recordFilePath = "");
+    ~SolverDaemon();
+    void run();
+    void stop();
+private:
+    std::string socketPath;
+    int workerCount;
+    size_t maxBatchSize;                // The largest number of queued requests a worker takes at once.
+    int listenFd;
+    SolutionCache* cache;               // Shared by every worker. Not owned by the daemon.
+    std::chrono::milliseconds maxDeadline;      // Requests without a deadline, or with a later one, get this one instead.
+    size_t stateLimit;                  // The most states a single sub-goal search may store, which bounds each worker's memory.
+    std::unordered_map<int, std::shared_ptr<const ModelTables>> tables;    // Built once for every supported board size and shared by all the workers.
+    std::atomic<bool> running;
+
+    std::mutex recordMutex;
+    int recordFd;                       // The file solved requests are appended to, or -1 if they are not recorded.
+
+    std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    std::deque<SolveRequest> requestQueue;      // Requests waiting for a worker, in arrival order.
+
+    std::mutex connectionsMutex;
+    std::condition_variable readersCondition;
+    std::vector<std::weak_ptr<ClientConnection>> connections;   // Open connections, so they can be shut down when the daemon stops.
+    int activeReaders;                  // Reader threads are detached; run() waits for this to reach zero before returning.
+    std::vector<std::thread> workerThreads;
+
+    void acceptConnections();
+    void readRequests(const std::shared_ptr<ClientConnection>& client);
+    void readClientRequests(const std::shared_ptr<ClientConnection>& client);
+    void workerLoop();
+    void processBatch(std::vector<SolveRequest>& batch);
+    void recordSolution(const std::string& board, const EncodedSolution& solution);
+    static void sendResponse(const std::shared_ptr<ClientConnection>& client, const std::string& buffer);
+    static void appendResponse(std::string& buffer, const uint32_t& requestId, const SolveStatus& status, const uint32_t& statesExplored,
+                               const uint32_t& queueMicroseconds, const uint32_t& solveMicroseconds, const EncodedSolution& solution);
+    static bool readFully(const int& fd, void* buffer, const size_t& size);
+    static bool writeFully(const int& fd, const char* buffer, size_t size);
+};
+
+#endif //SOLVERDAEMON_H
\ No newline at end of file
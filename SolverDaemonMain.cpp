@@ -0,0 +1,37 @@
+#include "SolverDaemon.h"
+#include <csignal>
+
+namespace
+{
+    SolverDaemon* activeDaemon = nullptr;
+
+    void handleSignal(int)
+    {
+        if(activeDaemon != nullptr)
+            activeDaemon->stop();
+    }
+}
+
+// Usage: SlidingPuzzleDaemon [socketPath] [workerCount] [maxBatchSize] [cacheFile] [cacheCapacity] [maxDeadlineMilliseconds] [stateLimit] [recordFile]
+// Pass an empty cacheFile to keep the solution cache in memory only. If a recordFile is given, every solved request is appended to it for SlidingPuzzleVerifier.
+int main(int argc, char* argv[])
+{
+    const std::string socketPath = argc > 1 ? argv[1] : "/tmp/sliding-puzzle-solver.sock";
+    const int workerCount = argc > 2 ? std::stoi(argv[2]) : static_cast<int>(std::thread::hardware_concurrency());
+    const size_t maxBatchSize = argc > 3 ? std::stoul(argv[3]) : 16;
+    const std::string cacheFile = argc > 4 ? argv[4] : "";
+    const size_t cacheCapacity = argc > 5 ? std::stoul(argv[5]) : 100000;
+    const std::chrono::milliseconds maxDeadline(argc > 6 ? std::stoul(argv[6]) : 10000);
+    const size_t stateLimit = argc > 7 ? std::stoul(argv[7]) : 250000;
+    const std::string recordFile = argc > 8 ? argv[8] : "";
+
+    SolutionCache cache(cacheCapacity, cacheFile);
+    SolverDaemon daemon(socketPath, workerCount, maxBatchSize, &cache, maxDeadline, stateLimit, recordFile);
+    activeDaemon = &daemon;
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+    daemon.run();
+    activeDaemon = nullptr;
+    std::cout << "Cache hits: " << cache.getHits() << ", cache misses: " << cache.getMisses() << '\n';
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include "SlidingPuzzleSolver.h"
+#include "SolutionVerifier.h"
+#include "SolutionCache.h"
+#include <iostream>
+
+/*
+ * Tests for the move encoding, the solution verifier, the solution cache and the solvability check. Each failed check is printed,
+ * and the exit code is the number of failed checks, so CTest reports any failure.
+ * Usage: SlidingPuzzleTests
+ */
+
+namespace
+{
+    int failedChecks = 0;
+
+    void check(const bool& condition, const std::string& description)
+    {
+        if(condition)
+            return;
+        failedChecks++;
+        std::cerr << "FAILED: " << description << '\n';
+    }
+
+    // A 4x4 board, scrambled from the solution so it is solvable.
+    const std::string solvableBoard = "ebcdafghnijkmolp";
+    const std::string solvedBoard = "abcdefghijklmnop";
+
+    // Input: A solvable board.
+    // Output: The pivot indices of the solver's solution, or an empty vector if the solve failed.
+    std::vector<int> solveBoard(const std::string& board)
+    {
+        Model model(board);
+        SlidingPuzzleSolver solver(model);
+        if(!solver.solve())
+            return {};
+        return model.getSolutionSteps();
+    }
+
+    void testMoveEncodingRoundTrip()
+    {
+        const std::vector<int> pivots = solveBoard(solvableBoard);
+        check(!pivots.empty(), "the scrambled 4x4 board is solved");
+        const EncodedSolution solution = EncodedSolution::encode(solvableBoard, pivots, 4);
+        check(solution.moveCount + 1 == pivots.size(), "every pivot pair is encoded as one move");
+        check(solution.decode(pivots.front(), 4) == pivots, "decode returns the encoded pivots");
+
+        std::string buffer;
+        solution.serialize(buffer);
+        check(buffer.size() == sizeof(uint64_t) + sizeof(uint32_t) + solution.packedMoves.size(), "serialize writes the header and the packed moves");
+        check(static_cast<uint8_t>(buffer[0]) == (solution.boardHash & 0xFF) && static_cast<uint8_t>(buffer[8]) == (solution.moveCount & 0xFF),
+              "integers are serialized least significant byte first");
+        const auto* data = reinterpret_cast<const uint8_t*>(buffer.data());
+        EncodedSolution deserialized;
+        check(EncodedSolution::deserialize(data, data + buffer.size(), deserialized), "deserialize reads a serialized solution");
+        check(deserialized.boardHash == solution.boardHash && deserialized.moveCount == solution.moveCount && deserialized.packedMoves == solution.packedMoves,
+              "deserialize returns the serialized solution");
+        data = reinterpret_cast<const uint8_t*>(buffer.data());
+        check(!EncodedSolution::deserialize(data, data + buffer.size() - 1, deserialized), "deserialize rejects a truncated solution");
+    }
+
+    void testGetMove()
+    {
+        check(EncodedSolution::getMove(5, 1, 4) == Up && EncodedSolution::getMove(5, 9, 4) == Down, "vertical moves are encoded");
+        check(EncodedSolution::getMove(5, 4, 4) == Left && EncodedSolution::getMove(5, 6, 4) == Right, "horizontal moves are encoded");
+        check(EncodedSolution::getMove(3, 4, 4) == InvalidMove && EncodedSolution::getMove(4, 3, 4) == InvalidMove, "moves that wrap across a row are invalid");
+        check(EncodedSolution::getMove(0, 5, 4) == InvalidMove && EncodedSolution::getMove(15, 15, 4) == InvalidMove, "pivots that are not adjacent are invalid");
+        check(EncodedSolution::getMove(15, 19, 4) == InvalidMove, "moves off the board are invalid");
+    }
+
+    void testSolutionVerifier()
+    {
+        const std::vector<int> pivots = solveBoard(solvableBoard);
+        const EncodedSolution solution = EncodedSolution::encode(solvableBoard, pivots, 4);
+        uint32_t failedMove = 0;
+        check(SolutionVerifier::verify(solvableBoard, solution, failedMove) == VerificationResult::Valid, "the solver's solution verifies");
+        check(SolutionVerifier::verify(solvedBoard, solution, failedMove) == VerificationResult::HashMismatch, "a solution replayed against another board is rejected");
+
+        // The empty space starts in the bottom right corner, so moving it down takes it off the board.
+        EncodedSolution illegalSolution;
+        illegalSolution.boardHash = EncodedSolution::hashBoard(solvedBoard);
+        illegalSolution.moveCount = 1;
+        illegalSolution.packedMoves = {Down};
+        check(SolutionVerifier::verify(solvedBoard, illegalSolution, failedMove) == VerificationResult::IllegalMove && failedMove == 0,
+              "a move off the board is rejected at its index");
+
+        // A pair of pivots that are not adjacent ends the encoded solution, so it no longer reaches the goal.
+        std::vector<int> skippingPivots = pivots;
+        skippingPivots.erase(skippingPivots.begin() + 1);
+        const EncodedSolution truncatedSolution = EncodedSolution::encode(solvableBoard, skippingPivots, 4);
+        check(truncatedSolution.moveCount == 0, "encode stops at the first pair of pivots that are not adjacent");
+        check(SolutionVerifier::verify(solvableBoard, truncatedSolution, failedMove) == VerificationResult::NotSolved, "a truncated solution is rejected");
+
+        std::string records;
+        SolutionVerifier::appendRecord(records, solvableBoard, solution);
+        SolutionVerifier::appendRecord(records, solvedBoard, illegalSolution);
+        SolutionVerifier::appendRecord(records, solvableBoard, truncatedSolution);
+        size_t recordCount = 0;
+        const std::vector<VerificationFailure> failures = SolutionVerifier::verifyRecords(reinterpret_cast<const uint8_t*>(records.data()), records.size(), 2, recordCount);
+        check(recordCount == 3, "every appended record is read back");
+        check(failures.size() == 2 && failures[0].recordIndex == 1 && failures[0].result == VerificationResult::IllegalMove
+              && failures[1].recordIndex == 2 && failures[1].result == VerificationResult::NotSolved, "only the bad records fail, in record order");
+        const std::vector<VerificationFailure> truncatedFailures = SolutionVerifier::verifyRecords(reinterpret_cast<const uint8_t*>(records.data()), records.size() - 1, 1, recordCount);
+        check(recordCount == 2 && !truncatedFailures.empty() && truncatedFailures.back().recordIndex == 2 && truncatedFailures.back().result == VerificationResult::Malformed,
+              "a truncated record is reported as malformed");
+    }
+
+    void testSolutionCacheRejectsBadReplay()
+    {
+        SolutionCache cache(100);
+        const Model startingModel(solvableBoard);
+        // Poison the first sub-goal with pivots that reach it, tile 0 ending up at index 0, but only by moving the empty space across the board in one step.
+        const uint64_t poisonedKey = cache.getKey(solvableBoard, {}, SubGoal({0}));
+        const std::vector<int> poisonedPivots = {startingModel.getPivotIndex(), 0, 4};
+        cache.store(poisonedKey, poisonedPivots);
+
+        Model model(solvableBoard);
+        SlidingPuzzleSolver solver(model);
+        solver.setCache(&cache);
+        check(solver.solve(), "the solve succeeds despite the poisoned entry");
+        const EncodedSolution solution = EncodedSolution::encode(solvableBoard, model.getSolutionSteps(), 4);
+        uint32_t failedMove = 0;
+        check(SolutionVerifier::verify(solvableBoard, solution, failedMove) == VerificationResult::Valid, "the solution found around the poisoned entry verifies");
+        check(cache.getHits() == 0 && cache.getMisses() > 0, "the poisoned entry counts as a miss");
+        std::vector<int> cachedPivots;
+        check(cache.lookup(poisonedKey, cachedPivots) && cachedPivots != poisonedPivots, "the poisoned entry is replaced by the searched solution");
+
+        Model cachedModel(solvableBoard);
+        SlidingPuzzleSolver cachedSolver(cachedModel);
+        cachedSolver.setCache(&cache);
+        const uint64_t missesBefore = cache.getMisses();
+        check(cachedSolver.solve() && cachedModel.getSolutionSteps() == model.getSolutionSteps(), "a second solve replays the cached solution");
+        check(cache.getMisses() == missesBefore && cachedSolver.getStatesExplored() == 0, "a second solve is served entirely from the cache");
+    }
+
+    void testIsSolvable()
+    {
+        check(SlidingPuzzleSolver::isSolvable("abcdefghi"), "the solved 3x3 board is solvable");
+        check(SlidingPuzzleSolver::isSolvable(solvedBoard), "the solved 4x4 board is solvable");
+        check(SlidingPuzzleSolver::isSolvable("abcdefghijklmnopqrstuvwxy"), "the solved 5x5 board is solvable");
+        check(SlidingPuzzleSolver::isSolvable(solvableBoard), "a scrambled 4x4 board is solvable");
+        check(SlidingPuzzleSolver::isSolvable("abcdefghijklmnpo"), "a 4x4 board one move from the solution is solvable");
+        check(!SlidingPuzzleSolver::isSolvable("abcdefhgi"), "a 3x3 board with two tiles swapped is unsolvable");
+        check(!SlidingPuzzleSolver::isSolvable("bacdefghijklmnop"), "a 4x4 board with two tiles swapped is unsolvable");
+        check(!SlidingPuzzleSolver::isSolvable("abcdefghijklmnopqrstuvxwy"), "a 5x5 board with two tiles swapped is unsolvable");
+    }
+}
+
+int main()
+{
+    testMoveEncodingRoundTrip();
+    testGetMove();
+    testSolutionVerifier();
+    testSolutionCacheRejectsBadReplay();
+    testIsSolvable();
+    if(failedChecks == 0)
+        std::cout << "All tests passed.\n";
+    return failedChecks;
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#ifndef SUBGOALCACHE_H
+#define SUBGOALCACHE_H
+#include <unordered_set>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SubGoal.h"
+
+/*
+ * What SlidingPuzzleSolver needs from a cache of sub-goal solutions (see SolutionCache). Header-only, so targets that never cache, like the GUI,
+ * do not have to build an implementation.
+ */
+class SubGoalCache
+{
+public:
+    virtual ~SubGoalCache() = default;
+    virtual uint64_t getKey(const std::string& board, const std::unordered_set<int>& lockedTiles, const SubGoal& subGoal) const = 0;
+    virtual bool lookup(const uint64_t& key, std::vector<int>& pivots) = 0;
+    virtual void store(const uint64_t& key, const std::vector<int>& pivots) = 0;
+    virtual void countLookup(const bool& isHit) = 0;
+};
+
+#endif //SUBGOALCACHE_H
\ No newline at end of file
@@ -1,8 +1,12 @@
 #include "SlidingPuzzleApp.h"
+#include <cstring>
 
-int main()
+// Usage: SlidingPuzzleApp [--real-time]
+// --real-time skips the offline solve and finds each move during playback with a bounded real-time search.
+int main(int argc, char* argv[])
 {
-    SlidingPuzzleApp app;
+    const bool realTime = argc > 1 && std::strcmp(argv[1], "--real-time") == 0;
+    SlidingPuzzleApp app(realTime);
     app.run();
     return 0;
 }
\ No newline at end of file